@@ -0,0 +1,409 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Store build and query benchmarks.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include "benchmark.h"
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/request.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/datastore/container.h>
+ #include <udjat/tools/datastore/iterator.h>
+ #include <algorithm>
+ #include <chrono>
+ #include <cstring>
+ #include <ctime>
+ #include <iostream>
+ #include <stdexcept>
+ #include <system_error>
+ #include <cerrno>
+
+ using namespace std;
+ using namespace Udjat;
+
+ namespace Udjat {
+
+	DataStore::Benchmark::Options::Options(int argc, char **argv) {
+
+		for(int arg = 1; arg < argc; arg++) {
+
+			const char *option = argv[arg];
+			if(strncmp(option,"--",2)) {
+				throw runtime_error(Logger::String{"Unexpected argument '",option,"'"});
+			}
+			option += 2;
+
+			const char *value = strchr(option,'=');
+			std::string name{value ? std::string{option,(size_t) (value-option)} : std::string{option}};
+			value = value ? value+1 : "";
+
+			if(name == "dir") {
+				dir = value;
+			} else if(name == "output") {
+				output = value;
+			} else if(name == "rows") {
+				rows = (size_t) stoull(value);
+			} else if(name == "files") {
+				files = (size_t) stoull(value);
+			} else if(name == "columns") {
+				columns = (size_t) stoull(value);
+			} else if(name == "types") {
+				types = value;
+			} else if(name == "cardinality") {
+				cardinality = (size_t) stoull(value);
+			} else if(name == "duplicates") {
+				duplicates = stod(value);
+			} else if(name == "seed") {
+				seed = (uint64_t) stoull(value);
+			} else if(name == "layout") {
+				layout = value;
+			} else if(name == "dictionary") {
+				dictionary = value;
+			} else if(name == "loads") {
+				loads = (size_t) stoull(value);
+			} else if(name == "iterations") {
+				iterations = (size_t) stoull(value);
+			} else if(name == "soak") {
+				soak = true;
+			} else if(name == "threads") {
+				threads = value;
+			} else if(name == "duration") {
+				duration = stod(value);
+			} else {
+				throw runtime_error(Logger::String{"Unexpected option '--",name.c_str(),"'"});
+			}
+
+		}
+
+		if(!rows) {
+			throw runtime_error("The number of rows should be greater than zero");
+		}
+
+	}
+
+	DataStore::Benchmark::Results::Results(const Options &options) {
+
+		if(options.output.empty()) {
+			out = stdout;
+		} else {
+			out = fopen(options.output.c_str(),"w");
+			if(!out) {
+				throw std::system_error(errno,std::system_category(),options.output);
+			}
+		}
+
+		fprintf(out,"name,iterations,seconds,cpu,ops,mean,p50,p99,p999,max,rows,bytes\n");
+		fflush(out);
+
+	}
+
+	DataStore::Benchmark::Results::~Results() {
+		if(out != stdout) {
+			fclose(out);
+		}
+	}
+
+	void DataStore::Benchmark::Results::write(const char *name, std::vector<uint64_t> &samples, size_t rows, size_t bytes) {
+
+		if(samples.empty()) {
+			return;
+		}
+
+		std::sort(samples.begin(),samples.end());
+
+		uint64_t total = 0;
+		for(uint64_t sample : samples) {
+			total += sample;
+		}
+
+		auto percentile = [&samples](double quantile) {
+			return samples[std::min(samples.size()-1,(size_t) (quantile * samples.size()))];
+		};
+
+		double seconds = ((double) total) / 1e9;
+
+		fprintf(
+			out,
+			"%s,%zu,%.6f,,%.1f,%.1f,%llu,%llu,%llu,%llu,%zu,%zu\n",
+			name,
+			samples.size(),
+			seconds,
+			seconds > 0 ? samples.size() / seconds : 0.0,
+			((double) total) / samples.size(),
+			(unsigned long long) percentile(0.5),
+			(unsigned long long) percentile(0.99),
+			(unsigned long long) percentile(0.999),
+			(unsigned long long) samples.back(),
+			rows,
+			bytes
+		);
+		fflush(out);
+
+	}
+
+	void DataStore::Benchmark::Results::write(const char *name, const QueryStatistics::Summary &summary, double seconds) {
+
+		// The summary times are in microseconds.
+		fprintf(
+			out,
+			"%s,%zu,%.6f,,%.1f,%.1f,%.0f,%.0f,%.0f,%.0f,%zu,%zu\n",
+			name,
+			summary.count,
+			seconds,
+			seconds > 0 ? summary.count / seconds : 0.0,
+			summary.mean * 1000,
+			summary.p50 * 1000,
+			summary.p99 * 1000,
+			summary.p999 * 1000,
+			summary.max * 1000,
+			summary.rows,
+			summary.bytes
+		);
+		fflush(out);
+
+	}
+
+	void DataStore::Benchmark::Results::write(const char *name, size_t iterations, double seconds, double cpu, size_t bytes) {
+		if(cpu < 0) {
+			fprintf(out,"%s,%zu,%.6f,,,,,,,,,%zu\n",name,iterations,seconds,bytes);
+		} else {
+			fprintf(out,"%s,%zu,%.6f,%.6f,,,,,,,,%zu\n",name,iterations,seconds,cpu,bytes);
+		}
+		fflush(out);
+	}
+
+	void DataStore::Benchmark::Results::write(const char *name, size_t value) {
+		fprintf(out,"%s,%zu,,,,,,,,,,\n",name,value);
+		fflush(out);
+	}
+
+	DataStore::Benchmark::Store::Store(const Generator &generator, const char *name) {
+
+		auto parsed = document.load_string(generator.xml(name).c_str());
+		if(!parsed) {
+			throw runtime_error(parsed.description());
+		}
+
+		XML::Node definition{document.document_element()};
+		container = std::make_unique<Container>(definition);
+		for(XML::Node child = definition.child("api-call"); child; child = child.next_sibling("api-call")) {
+			container->push_back(child);
+		}
+
+	}
+
+	/// @brief Run a query benchmark.
+	/// @param query The query, returns the number of rows.
+	template <typename T>
+	static void measure(DataStore::Benchmark::Results &results, const char *name, size_t iterations, T query) {
+
+		std::vector<uint64_t> samples;
+		samples.reserve(iterations);
+
+		size_t rows = 0;
+		for(size_t ix = 0; ix < iterations; ix++) {
+			auto started = std::chrono::steady_clock::now();
+			rows += query(ix);
+			samples.push_back((uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+		}
+
+		results.write(name,samples,rows);
+
+	}
+
+	void DataStore::Benchmark::run(const Options &options, Results &results) {
+
+		Generator generator{options};
+		generator.write();
+
+		Store store{generator,"benchmark"};
+		Container &container{*store.container};
+
+		// Store builds.
+		{
+			std::vector<LoadStatistics> builds;
+			double wall = 0, cpu = 0;
+
+			for(size_t load = 0; load < std::max(options.loads,(size_t) 1); load++) {
+
+				auto started = std::chrono::steady_clock::now();
+				std::clock_t clock = std::clock();
+
+				container.load();
+
+				wall += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+				cpu += ((double) (std::clock() - clock)) / CLOCKS_PER_SEC;
+
+				auto history{container.statistics()};
+				if(!history.empty()) {
+					builds.push_back(history.front());
+				}
+
+			}
+
+			results.write("load",builds.size(),wall,cpu,builds.empty() ? 0 : builds.back().length);
+
+			// Build phases, added together for all builds.
+			if(!builds.empty()) {
+				for(const auto &phase : builds.front().phases) {
+
+					double wall = 0, cpu = 0;
+					size_t bytes = 0;
+
+					for(const auto &build : builds) {
+						const LoadStatistics::Phase *item = build.phase(phase.name);
+						if(item) {
+							wall += item->wall;
+							cpu += item->cpu;
+							bytes += item->bytes;
+						}
+					}
+
+					results.write((std::string{"load/"} + phase.name).c_str(),builds.size(),wall,cpu,bytes / builds.size());
+
+				}
+			}
+
+		}
+
+		// Queries, the random rows are the same on every run.
+		size_t iterations = std::max(options.iterations,(size_t) 1);
+		uint64_t state = options.seed;
+		std::vector<size_t> rows;
+		rows.reserve(iterations);
+		for(size_t ix = 0; ix < iterations; ix++) {
+			rows.push_back(Generator::random(state) % options.rows);
+		}
+
+		std::vector<std::string> keys;
+		keys.reserve(iterations);
+		for(size_t row : rows) {
+			keys.push_back(generator.name(row));
+		}
+
+		measure(results,"query/primary",iterations,[&container,&keys](size_t ix) -> size_t {
+			auto it = container.find(keys[ix].c_str());
+			return (it && !it.primary_key().empty()) ? 1 : 0;
+		});
+
+		for(size_t ix = 0; ix < iterations; ix++) {
+			keys[ix] = "site/" + generator.site(rows[ix]);
+		}
+
+		measure(results,"query/index",iterations,[&container,&keys](size_t ix) -> size_t {
+			auto it = container.find(keys[ix].c_str());
+			return (it && !it.primary_key().empty()) ? 1 : 0;
+		});
+
+		// Prefix scans, the last hex digit removed selects up to 16 keys.
+		for(size_t ix = 0; ix < iterations; ix++) {
+			std::string key{generator.name(rows[ix])};
+			keys[ix] = key.substr(0,key.size()-1);
+		}
+
+		measure(results,"query/prefix",iterations,[&container,&keys](size_t ix) -> size_t {
+			size_t rows = 0;
+			for(auto it = container.find(keys[ix].c_str()); it; ++it) {
+				rows++;
+			}
+			return rows;
+		});
+
+		for(size_t ix = 0; ix < iterations; ix++) {
+			keys[ix] = "/net/" + generator.address(rows[ix]);
+		}
+
+		measure(results,"query/netv4",iterations,[&container,&keys](size_t ix) -> size_t {
+			Request request{keys[ix].c_str()};
+			auto it = container.find(request);
+			return it ? it.count() : 0;
+		});
+
+		// The full scans are slower, run less of them.
+		size_t scans = std::max(iterations / 1000,(size_t) 10);
+
+		for(size_t ix = 0; ix < scans; ix++) {
+			keys[ix] = "site/contains/" + generator.site(rows[ix]).substr(2);
+		}
+
+		measure(results,"query/contains",scans,[&container,&keys](size_t ix) -> size_t {
+			auto it = container.find(keys[ix].c_str());
+			return it ? it.count() : 0;
+		});
+
+		// Table serialization, all the columns of the rows with the same site.
+		{
+			std::vector<uint64_t> samples;
+			size_t rows = 0, bytes = 0;
+			std::string text;
+
+			for(size_t ix = 0; ix < scans; ix++) {
+
+				auto started = std::chrono::steady_clock::now();
+
+				text.clear();
+				auto it = container.find(("site/" + generator.site(ix)).c_str());
+				for(; it; ++it) {
+					for(size_t col = 0; col < container.columns().size(); col++) {
+						if(col) {
+							text += ';';
+						}
+						text += it[col];
+					}
+					text += '\n';
+					rows++;
+				}
+				bytes += text.size();
+
+				samples.push_back((uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+			}
+
+			results.write("serialize",samples,rows,bytes);
+		}
+
+	}
+
+ }
+
+ int main(int argc, char **argv) {
+
+	try {
+
+		DataStore::Benchmark::Options options{argc,argv};
+		DataStore::Benchmark::Results results{options};
+		if(options.soak) {
+			DataStore::Benchmark::soak(options,results);
+		} else {
+			DataStore::Benchmark::run(options,results);
+		}
+
+	} catch(const std::exception &e) {
+
+		cerr << e.what() << endl;
+		return -1;
+
+	}
+
+	return 0;
+
+ }
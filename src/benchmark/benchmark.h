@@ -0,0 +1,156 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare the benchmark tools.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/datastore/container.h>
+ #include <udjat/tools/datastore/statistics.h>
+ #include <cstdint>
+ #include <cstdio>
+ #include <memory>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+ 	namespace DataStore {
+
+		namespace Benchmark {
+
+			/// @brief Benchmark options, from the command line ('--name=value').
+			struct Options {
+
+				std::string dir{".bin/benchmark"};	///< @brief Directory for the generated sources.
+				std::string output;				///< @brief The results file, empty for stdout.
+
+				size_t rows = 100000;			///< @brief Number of rows.
+				size_t files = 1;				///< @brief Number of source files.
+				size_t columns = 4;				///< @brief Number of extra (non indexed) columns.
+				std::string types{"string"};	///< @brief Types of the extra columns, comma separated and cycled.
+				size_t cardinality = 100;		///< @brief Distinct values on the indexed and extra columns.
+				double duplicates = 0;			///< @brief Ratio of rows repeating a previous primary key.
+				uint64_t seed = 1;				///< @brief Random seed, the same seed generates the same sources.
+
+				std::string layout{"row"};		///< @brief The store layout (row or columnar).
+				std::string dictionary{"false"};	///< @brief Dictionary encoding of the string columns.
+
+				size_t loads = 3;				///< @brief Number of store builds.
+				size_t iterations = 100000;		///< @brief Number of queries on each benchmark.
+
+				bool soak = false;				///< @brief Run the reload under load benchmark.
+				std::string threads{"1,2,4,8"};	///< @brief Reader thread counts, comma separated.
+				double duration = 5;			///< @brief Seconds for each thread count.
+
+				Options(int argc, char **argv);
+
+			};
+
+			/// @brief Deterministic CSV generator.
+			/// @details Generates the columns 'name' (primary key), 'site' (indexed string), 'port' (indexed uint),
+			/// 'network' (indexed ipv4), 'netmask' (ipv4) and the extra columns 'c1' to 'cN'.
+			class Generator {
+			private:
+				const Options &options;
+
+				/// @brief The primary key of a row.
+				size_t key(size_t row) const noexcept;
+
+			public:
+				Generator(const Options &options) : options{options} {
+				}
+
+				/// @brief Write the source files.
+				/// @param generation Changes the contents of the extra columns, the keys are the same.
+				void write(size_t generation = 0) const;
+
+				/// @brief Get the container definition for the generated sources.
+				/// @param name The container name.
+				std::string xml(const char *name) const;
+
+				/// @brief Get a primary key.
+				std::string name(size_t row) const;
+
+				/// @brief Get a value of the 'site' column.
+				std::string site(size_t value) const;
+
+				/// @brief Get an address inside the network of a row.
+				std::string address(size_t row) const;
+
+				/// @brief Get a random number from the generator seed.
+				/// @details Not using the std distributions, they are implementation defined.
+				static uint64_t random(uint64_t &state) noexcept;
+
+			};
+
+			/// @brief Container for the generated sources.
+			struct Store {
+
+				pugi::xml_document document;			///< @brief The container definition.
+				std::unique_ptr<Container> container;
+
+				Store(const Generator &generator, const char *name);
+
+			};
+
+			/// @brief Benchmark results, one CSV line for each benchmark.
+			class Results {
+			private:
+				FILE *out;
+
+			public:
+				Results(const Options &options);
+				~Results();
+
+				/// @brief Write the result of a query benchmark.
+				/// @param name The benchmark name.
+				/// @param samples The latency of each query, in nanoseconds (sorted on return).
+				/// @param rows The rows returned.
+				/// @param bytes The bytes serialized.
+				void write(const char *name, std::vector<uint64_t> &samples, size_t rows, size_t bytes = 0);
+
+				/// @brief Write the result of concurrent queries.
+				/// @param summary The query counters.
+				/// @param seconds The elapsed time.
+				void write(const char *name, const QueryStatistics::Summary &summary, double seconds);
+
+				/// @brief Write the result of a build phase.
+				/// @param cpu The processor time, negative if unknown.
+				void write(const char *name, size_t iterations, double seconds, double cpu, size_t bytes);
+
+				/// @brief Write a counter, on the 'iterations' field.
+				void write(const char *name, size_t value);
+
+			};
+
+			/// @brief Run the store build and query benchmarks.
+			void run(const Options &options, Results &results);
+
+			/// @brief Run the reader threads while another one rebuilds the store from changing sources.
+			void soak(const Options &options, Results &results);
+
+		}
+
+	}
+
+ }
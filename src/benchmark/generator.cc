@@ -0,0 +1,208 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the synthetic CSV generator.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include "benchmark.h"
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <filesystem>
+ #include <stdexcept>
+ #include <system_error>
+ #include <cerrno>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Get the random value for a cell, independent of the order the cells are generated.
+	static uint64_t cell(uint64_t seed, size_t row, size_t column, size_t generation = 0) noexcept {
+		uint64_t state = seed ^ (row * 0x9E3779B97F4A7C15ULL) ^ ((column + 1) * 0xC2B2AE3D27D4EB4FULL) ^ (generation * 0x165667B19E3779F9ULL);
+		return DataStore::Benchmark::Generator::random(state);
+	}
+
+	static std::string ipv4(uint32_t addr) {
+		char buffer[20];
+		snprintf(buffer,sizeof(buffer),"%u.%u.%u.%u",(addr >> 24) & 0xff,(addr >> 16) & 0xff,(addr >> 8) & 0xff,addr & 0xff);
+		return buffer;
+	}
+
+	/// @brief The network of a row, a /24 starting from 10.0.0.0.
+	static uint32_t network(size_t row) noexcept {
+		return (uint32_t) ((10U << 24) + (row << 8));
+	}
+
+	uint64_t DataStore::Benchmark::Generator::random(uint64_t &state) noexcept {
+		// splitmix64
+		uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	size_t DataStore::Benchmark::Generator::key(size_t row) const noexcept {
+
+		if(options.duplicates <= 0) {
+			return row;
+		}
+
+		// Duplicated rows repeat the key of a previous one.
+		while(row && (cell(options.seed,row,0) % 1000000) < (uint64_t) (options.duplicates * 1000000)) {
+			row = cell(options.seed,row,1) % row;
+		}
+
+		return row;
+	}
+
+	std::string DataStore::Benchmark::Generator::name(size_t row) const {
+		char buffer[20];
+		snprintf(buffer,sizeof(buffer),"h%08zx",key(row));
+		return buffer;
+	}
+
+	std::string DataStore::Benchmark::Generator::site(size_t value) const {
+		char buffer[32];
+		snprintf(buffer,sizeof(buffer),"site-%04zu",value % options.cardinality);
+		return buffer;
+	}
+
+	std::string DataStore::Benchmark::Generator::address(size_t row) const {
+		return ipv4(network(row) + 1 + (uint32_t) (cell(options.seed,row,2) % 254));
+	}
+
+	void DataStore::Benchmark::Generator::write(size_t generation) const {
+
+		if(!options.files || !options.cardinality) {
+			throw runtime_error("The number of files and the cardinality should be greater than zero");
+		}
+
+		std::filesystem::create_directories(options.dir);
+
+		// Remove the sources of previous runs, they could have more files.
+		if(!generation) {
+			for(const auto &entry : std::filesystem::directory_iterator(options.dir)) {
+				std::string filename{entry.path().filename().string()};
+				if(!strncmp(filename.c_str(),"bench-",6) && filename.size() > 4 && !strcmp(filename.c_str()+filename.size()-4,".csv")) {
+					std::filesystem::remove(entry.path());
+				}
+			}
+		}
+
+		std::vector<String> types{String{options.types}.split(",")};
+		if(types.empty()) {
+			throw runtime_error("Required option 'types' is empty");
+		}
+
+		for(size_t file = 0; file < options.files; file++) {
+
+			char filename[32];
+			snprintf(filename,sizeof(filename),"bench-%03zu.csv",file);
+			std::string path{options.dir + "/" + filename};
+
+			FILE *out = fopen(path.c_str(),"w");
+			if(!out) {
+				throw std::system_error(errno,std::system_category(),path);
+			}
+
+			fprintf(out,"name;site;port;network;netmask");
+			for(size_t column = 0; column < options.columns; column++) {
+				fprintf(out,";c%zu",column+1);
+			}
+			fprintf(out,"\n");
+
+			for(size_t row = file; row < options.rows; row += options.files) {
+
+				fprintf(
+					out,
+					"%s;%s;%u;%s;255.255.255.0",
+					name(row).c_str(),
+					site(cell(options.seed,row,3)).c_str(),
+					(unsigned int) (1 + (cell(options.seed,row,4) % options.cardinality)),
+					ipv4(network(row)).c_str()
+				);
+
+				for(size_t column = 0; column < options.columns; column++) {
+
+					uint64_t value = cell(options.seed,row,column+5,generation) % options.cardinality;
+					const String &type{types[column % types.size()]};
+
+					if(!strcasecmp(type.c_str(),"string")) {
+						fprintf(out,";value-%llu",(unsigned long long) value);
+					} else if(!strcasecmp(type.c_str(),"uint")) {
+						fprintf(out,";%llu",(unsigned long long) value);
+					} else if(!strcasecmp(type.c_str(),"int")) {
+						fprintf(out,";%lld",((long long) value) - (long long) (options.cardinality / 2));
+					} else if(!strcasecmp(type.c_str(),"ipv4")) {
+						fprintf(out,";%s",ipv4((172U << 24) + (16U << 16) + (uint32_t) value).c_str());
+					} else if(!strcasecmp(type.c_str(),"bool")) {
+						fprintf(out,";%s",(value & 1) ? "true" : "false");
+					} else {
+						fclose(out);
+						throw runtime_error(Logger::String{"Unexpected column type '",type.c_str(),"'"});
+					}
+
+				}
+
+				fprintf(out,"\n");
+			}
+
+			if(fclose(out)) {
+				throw std::system_error(errno,std::system_category(),path);
+			}
+
+		}
+
+	}
+
+	std::string DataStore::Benchmark::Generator::xml(const char *name) const {
+
+		std::string dictionary{" dictionary=\"" + options.dictionary + "\""};
+
+		std::string xml{"<csv name=\""};
+		xml += name;
+		xml += "\" sources-from=\"" + options.dir + "\" sources-file-filter=\"bench-.*\\.csv\" layout=\"" + options.layout + "\">";
+
+		xml += "<column name=\"name\" primary-key=\"true\"" + dictionary + " />";
+		xml += "<column name=\"site\" index=\"true\"" + dictionary + " />";
+		xml += "<column name=\"port\" type=\"uint\" index=\"true\" />";
+		xml += "<column name=\"network\" type=\"ipv4\" index=\"true\" />";
+		xml += "<column name=\"netmask\" type=\"ipv4\" />";
+
+		std::vector<String> types{String{options.types}.split(",")};
+		for(size_t column = 0; column < options.columns && !types.empty(); column++) {
+			const String &type{types[column % types.size()]};
+			xml += "<column name=\"c" + std::to_string(column+1) + "\" type=\"" + type + "\"";
+			if(!strcasecmp(type.c_str(),"string")) {
+				xml += dictionary;
+			}
+			xml += " />";
+		}
+
+		xml += "<api-call path=\"/net\" search-engine=\"netv4\" network-from=\"network\" mask-from=\"netmask\" />";
+		xml += "</csv>";
+
+		return xml;
+	}
+
+ }
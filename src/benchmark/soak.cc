@@ -0,0 +1,223 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Reload under load benchmark.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include "benchmark.h"
+ #include <udjat/tools/request.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/datastore/container.h>
+ #include <udjat/tools/datastore/iterator.h>
+ #include <udjat/tools/datastore/statistics.h>
+ #include <algorithm>
+ #include <atomic>
+ #include <chrono>
+ #include <iostream>
+ #include <thread>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	void DataStore::Benchmark::soak(const Options &options, Results &results) {
+
+		Generator generator{options};
+		generator.write();
+
+		Store store{generator,"soak"};
+		Container &container{*store.container};
+		container.load();
+
+		// The queries, the same for every thread count.
+		size_t count = std::max(options.iterations,(size_t) 1);
+		std::vector<std::string> primary, index, network;
+		{
+			uint64_t state = options.seed;
+			for(size_t ix = 0; ix < count; ix++) {
+				size_t row = Generator::random(state) % options.rows;
+				primary.push_back(generator.name(row));
+				index.push_back("site/" + generator.site(row));
+				network.push_back("/net/" + generator.address(row));
+			}
+		}
+
+		size_t generation = 0;
+
+		for(const auto &value : String{options.threads}.split(",")) {
+
+			size_t threads = (size_t) stoul(value.c_str());
+			if(!threads) {
+				continue;
+			}
+
+			for(bool reload : { false, true }) {
+
+				// 'Other' gets all the queries, for the mixed latency.
+				QueryStatistics stats;
+				std::atomic<bool> running{true};
+				std::atomic<size_t> errors{0};
+
+				std::vector<std::thread> readers;
+				for(size_t thread = 0; thread < threads; thread++) {
+
+					readers.emplace_back([&,thread](){
+
+						size_t ix = thread * 7919;
+						while(running.load(std::memory_order_relaxed)) {
+
+							size_t query = (ix++) % count;
+							QueryStatistics::Kind kind;
+							size_t rows = 0;
+
+							auto started = std::chrono::steady_clock::now();
+
+							try {
+
+								switch(ix % 3) {
+								case 0:
+									{
+										kind = QueryStatistics::Primary;
+										auto it = container.find(primary[query].c_str());
+										rows = (it && !it.primary_key().empty()) ? 1 : 0;
+									}
+									break;
+
+								case 1:
+									{
+										kind = QueryStatistics::Index;
+										auto it = container.find(index[query].c_str());
+										rows = (it && !it.primary_key().empty()) ? 1 : 0;
+									}
+									break;
+
+								default:
+									{
+										kind = QueryStatistics::NetV4;
+										Request request{network[query].c_str()};
+										auto it = container.find(request);
+										rows = it ? it.count() : 0;
+									}
+
+								}
+
+							} catch(const std::exception &) {
+
+								errors++;
+								continue;
+
+							}
+
+							uint64_t nanoseconds = (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+							stats.record(kind,nanoseconds,rows);
+							stats.record(QueryStatistics::Other,nanoseconds,rows);
+
+						}
+
+					});
+
+				}
+
+				// Rebuild the store from changing sources until the readers are done.
+				size_t builds = 0;
+				double build_time = 0;
+				size_t alive = 1;
+				std::thread reloader;
+
+				if(reload) {
+
+					reloader = std::thread([&](){
+
+						// The generations still mapped, the active one or pinned by a reader.
+						std::vector<std::weak_ptr<File>> generations{container.snapshot()};
+
+						while(running.load(std::memory_order_relaxed)) {
+
+							generator.write(++generation);
+
+							auto started = std::chrono::steady_clock::now();
+							try {
+								container.load();
+							} catch(const std::exception &e) {
+								cerr << "Build failed: " << e.what() << endl;
+								errors++;
+								continue;
+							}
+							build_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+							builds++;
+
+							generations.erase(
+								std::remove_if(generations.begin(),generations.end(),[](const std::weak_ptr<File> &file){
+									return file.expired();
+								}),
+								generations.end()
+							);
+							generations.push_back(container.snapshot());
+							alive = std::max(alive,generations.size());
+
+						}
+
+					});
+
+				}
+
+				auto started = std::chrono::steady_clock::now();
+				std::this_thread::sleep_for(std::chrono::duration<double>(options.duration));
+				running = false;
+
+				for(auto &reader : readers) {
+					reader.join();
+				}
+				double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+				if(reloader.joinable()) {
+					reloader.join();
+				}
+
+				std::string name{"soak/"};
+				name += (reload ? "reload/" : "quiet/");
+				name += std::to_string(threads);
+
+				for(const auto &summary : stats.summary()) {
+					if(summary.kind == QueryStatistics::Other) {
+						results.write(name.c_str(),summary,seconds);
+					} else {
+						results.write((name + "/" + QueryStatistics::to_string(summary.kind)).c_str(),summary,seconds);
+					}
+				}
+
+				if(reload) {
+					results.write((name + "/load").c_str(),builds,build_time,-1,container.snapshot()->size());
+					results.write((name + "/generations").c_str(),alive);
+				}
+
+				if(errors) {
+					results.write((name + "/errors").c_str(),errors.load());
+				}
+
+			}
+
+		}
+
+	}
+
+ }
@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare row bitmap.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/datastore/column.h>
+ #include <functional>
+ #include <memory>
+ #include <vector>
+
+ namespace Udjat {
+
+ 	namespace DataStore {
+
+		/// @brief Set of primary index rows.
+		class UDJAT_PRIVATE Bitmap {
+		private:
+
+			/// @brief Number of rows.
+			size_t rows;
+
+			/// @brief The bits, one for each row.
+			std::vector<uint64_t> words;
+
+		public:
+
+			/// @brief Rows on each bitmap container.
+			static constexpr size_t block = 65536;
+
+			/// @brief Build an empty bitmap.
+			/// @param rows The number of rows.
+			Bitmap(size_t rows);
+
+			/// @brief Load bitmap from file.
+			/// @param rows The number of rows.
+			/// @param offset The offset of the bitmap on file.
+			Bitmap(const File &file, size_t rows, size_t offset);
+
+			/// @brief Evaluate bitmap expression.
+			/// @param expression Terms as 'column/value' joined by 'and' or 'or', 'not' inverts the next term ('site/rio/and/not/status/down').
+			/// @return The selected rows.
+			static Bitmap Factory(std::shared_ptr<File> file, const std::vector<std::shared_ptr<Abstract::Column>> &cols, const char *expression);
+
+			/// @brief Write bitmap on file.
+			/// @param rows The selected rows, sorted.
+			/// @return The bitmap offset.
+			static size_t write(File &file, const std::vector<size_t> &rows);
+
+			Bitmap & operator&=(const Bitmap &bitmap);
+			Bitmap & operator|=(const Bitmap &bitmap);
+
+			/// @brief Select the rows not selected and unselect the others.
+			void invert();
+
+			/// @brief Get the number of selected rows.
+			size_t count() const noexcept;
+
+			/// @brief Call method for each selected row.
+			void for_each(const std::function<void(size_t row)> &method) const;
+
+		};
+
+ 	}
+
+ }
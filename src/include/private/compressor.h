@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare string compressor.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <private/structs.h>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+ 	namespace DataStore {
+
+		/// @brief Static symbol table string compressor (FSST like).
+		class UDJAT_PRIVATE Compressor {
+		private:
+
+			/// @brief The symbol table.
+			SymbolTable table;
+
+			/// @brief Symbol codes for each first byte, longest symbols first.
+			std::vector<uint8_t> candidates[256];
+
+			/// @brief Rebuild candidate lists from symbol table.
+			void rebuild();
+
+			/// @brief Get longest symbol matching text.
+			/// @return The symbol code, 0 if none.
+			uint8_t find(const char *text) const noexcept;
+
+		public:
+
+			/// @brief Code for literal bytes.
+			static constexpr uint8_t Escape = 255;
+
+			/// @brief Build compressor, train the symbol table.
+			/// @param sample The sample strings.
+			Compressor(const std::vector<std::string> &sample);
+
+			/// @brief The trained symbol table.
+			inline const SymbolTable & symbols() const noexcept {
+				return table;
+			}
+
+			/// @brief Compress string.
+			/// @return The symbol codes (without the terminating 0).
+			std::string encode(const char *text) const;
+
+			/// @brief Decompress string.
+			/// @param table The symbol table.
+			/// @param data The compressed string.
+			static std::string decode(const SymbolTable &table, const char *data);
+
+		};
+
+ 	}
+
+ }
@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare row filter.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/iterator.h>
+ #include <memory>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+ 	namespace DataStore {
+
+		class Postings;
+
+		/// @brief Row filter, compiled from a predicate expression.
+		/// @details Predicates are 'column<op>value' with the operators =, !=, <, <=, >, >= and ~ (contains),
+		/// joined by '&' (or ',') and '|'; '!' negates the next term and parentheses group terms.
+		class UDJAT_PRIVATE Filter {
+		public:
+
+			/// @brief Comparison operator.
+			enum Operator : uint8_t {
+				Equal,
+				NotEqual,
+				Less,
+				LessOrEqual,
+				Greater,
+				GreaterOrEqual,
+				Contains,
+			};
+
+			/// @brief Expression node.
+			class Node {
+			public:
+				virtual ~Node();
+
+				/// @brief Evaluate node for a batch of rows.
+				/// @param rows The rows to test.
+				/// @param count The number of rows.
+				/// @param selected Output, 1 for the rows matching the node, 0 for the others.
+				virtual void evaluate(const Row *rows, size_t count, uint8_t *selected) const = 0;
+
+				/// @brief Get the records from the indexes.
+				/// @param records Output, a superset of the records matching the node.
+				/// @return false if the node can't be resolved from indexes.
+				virtual bool select(Postings &records) const;
+			};
+
+			/// @brief Maximum number of rows for each evaluation.
+			static constexpr size_t batch = 1024;
+
+		private:
+
+			std::shared_ptr<File> file;
+			std::vector<std::shared_ptr<Abstract::Column>> cols;
+
+			/// @brief The expression tree.
+			std::shared_ptr<Node> root;
+
+			std::shared_ptr<Node> parse_or(const char * &ptr);
+			std::shared_ptr<Node> parse_and(const char * &ptr);
+			std::shared_ptr<Node> parse_unary(const char * &ptr);
+
+			/// @brief Build typed comparison for predicate.
+			std::shared_ptr<Node> predicate(uint16_t column, Operator op, const std::string &value) const;
+
+		public:
+			Filter(std::shared_ptr<File> file, const std::vector<std::shared_ptr<Abstract::Column>> &cols, const char *expression);
+
+			/// @brief Evaluate filter for a batch of rows.
+			/// @see Node::evaluate
+			inline void evaluate(const Row *rows, size_t count, uint8_t *selected) const {
+				root->evaluate(rows,count,selected);
+			}
+
+			/// @brief Get handler selecting rows from the indexes.
+			/// @details Predicates on indexed columns are resolved to sorted record lists, intersected
+			/// for '&' and merged for '|' before any row is read.
+			/// @return Handler selecting a superset of the matching rows (on primary index order), empty if the indexes can't be used.
+			std::shared_ptr<Iterator::Handler> index() const;
+
+		};
+
+ 	}
+
+ }
@@ -24,6 +24,7 @@
  #pragma once
  #include <udjat/defs.h>
  #include <udjat/tools/datastore/iterator.h>
+ #include <udjat/tools/datastore/statistics.h>
  #include <vector>
 
  namespace Udjat {
@@ -37,15 +38,15 @@
 				return it.row;
 			}
 
-			inline auto cols(const Iterator &it) const noexcept {
+			inline const std::vector<std::shared_ptr<Abstract::Column>> & cols(const Iterator &it) const noexcept {
 				return it.cols;
 			}
 
-			inline auto file(const Iterator &it) const noexcept {
+			inline const std::shared_ptr<File> & file(const Iterator &it) const noexcept {
 				return it.file;
 			}
 
-			inline auto handler(const Iterator &it) const noexcept {
+			inline const std::shared_ptr<Handler> & handler(const Iterator &it) const noexcept {
 				return it.handler;
 			}
 
@@ -57,17 +58,24 @@
 			static uint16_t search_column_id(const Iterator &it, const char *colname);
 
 			/// @brief Get pointer to selected row.
-			virtual const size_t * rowptr(const Iterator &it) const = 0;
+			virtual Row rowptr(const Iterator &it) const = 0;
 
 			/// @brief The filter expression.
 			virtual int filter(const Iterator &it) const = 0;
 
+			/// @brief Is the selected row equal to the search key?
+			/// @return true if the full value matches the key, not only a prefix of it.
+			virtual bool equal(const Iterator &it) const;
+
 			/// @brief Get Record count;
 			virtual size_t size() const = 0;
 
 			/// @brief Set search key.
 			virtual void key(const char *key) = 0;
 
+			/// @brief The query kind, for the latency statistics.
+			virtual QueryStatistics::Kind kind() const noexcept;
+
 		};
 
 		/// @brief Handler for primary key index.
@@ -80,25 +88,48 @@
 			/// @brief Pointer to the index data.
 			const size_t *ixptr = nullptr;
 
+			/// @brief Is the store using the columnar layout?
+			bool columnar = false;
+
 		public:
 			PrimaryKeyHandler(const std::shared_ptr<DataStore::File> file, const char *search_key = "");
 			PrimaryKeyHandler(const Iterator &it, const char *search_key = "");
 			virtual ~PrimaryKeyHandler();
 
-			const size_t * rowptr(const Iterator &it) const override;
+			Row rowptr(const Iterator &it) const override;
 			int filter(const Iterator &it) const override;
+			bool equal(const Iterator &it) const override;
 			size_t size() const override;
 			void key(const char *key) override;
+			QueryStatistics::Kind kind() const noexcept override;
 
 		};
 
 		/// @brief Handler for column based index.
 		class UDJAT_API ColumnKeyHandler : public PrimaryKeyHandler {
-		private:
+		protected:
 
 			/// @brief Key column number.
 			uint16_t colnumber;
 
+			/// @brief The search key, converted on the first comparison.
+			mutable struct {
+				bool valid = false;			///< @brief Is the key converted?
+				Abstract::Column::Key key;	///< @brief The converted key.
+				bool codes = false;			///< @brief Is the column using a sorted dictionary?
+				size_t from = 0;			///< @brief First code with the key prefix.
+				size_t to = 0;				///< @brief Code after the last one with the key prefix.
+				Abstract::Column::Key value;	///< @brief The converted key, for full value comparisons.
+			} parsed;
+
+			/// @brief Convert the search key for the column.
+			void parse(const Iterator &it) const;
+
+			/// @brief Binary search for key on the column index.
+			/// @param upper If true get the first entry after key, if false the first entry not before it.
+			/// @return The index entry number.
+			size_t bound(const Iterator &it, const char *key, bool upper) const;
+
 		public:
 			ColumnKeyHandler(const std::shared_ptr<DataStore::File> file, uint16_t colnumber, const char *search_key = "");
 			ColumnKeyHandler(const Iterator &it, uint16_t colnumber, const char *search_key = "");
@@ -106,8 +137,68 @@
 
 			virtual ~ColumnKeyHandler();
 
-			const size_t * rowptr(const Iterator &it) const override;
+			Row rowptr(const Iterator &it) const override;
+			int filter(const Iterator &it) const override;
+			bool equal(const Iterator &it) const override;
+			void key(const char *key) override;
+			QueryStatistics::Kind kind() const noexcept override;
+
+		};
+
+		/// @brief Handler for a range of column based index.
+		class UDJAT_API RangeKeyHandler : public ColumnKeyHandler {
+		private:
+
+			size_t first = 0;	///< @brief First index entry on range.
+			size_t last = 0;	///< @brief Index entry after the range.
+
+		public:
+			/// @param from The lowest value (nullptr for none).
+			/// @param to The highest value (nullptr for none).
+			/// @param inclusive If false, exclude from & to from the range.
+			RangeKeyHandler(const Iterator &it, uint16_t colnumber, const char *from, const char *to, bool inclusive = true);
+
+			/// @brief Get the index entries (record ids) on range.
+			inline const size_t * entries() const noexcept {
+				return ixptr + 1 + first;
+			}
+
+			Row rowptr(const Iterator &it) const override;
+			int filter(const Iterator &it) const override;
+			size_t size() const override;
+			void key(const char *key) override;
+			QueryStatistics::Kind kind() const noexcept override;
+
+		};
+
+		/// @brief Handler for composite (multi-column) index.
+		class UDJAT_API CompositeKeyHandler : public Iterator::Handler {
+		private:
+
+			const size_t *ixptr = nullptr;		///< @brief Pointer to the index data.
+			const uint16_t *columns = nullptr;	///< @brief The key columns.
+			uint16_t qtdcols = 0;				///< @brief Number of key columns.
+
+			size_t first = 0;	///< @brief First index entry on selection.
+			size_t last = 0;	///< @brief Index entry after the selection.
+
+			/// @brief Compare index entry with the search keys.
+			int comp(const Iterator &it, size_t entry, const std::vector<Abstract::Column::Key> &keys) const;
+
+		public:
+			/// @param offset The offset of the composite index section.
+			/// @param keys The search keys, separated by '/', for the leading key columns.
+			CompositeKeyHandler(const Iterator &it, size_t offset, const char *keys);
+
+			/// @brief Get composite index section from name.
+			/// @return Offset of the index section or 0 if not found.
+			static size_t find(const std::shared_ptr<DataStore::File> file, const char *name);
+
+			Row rowptr(const Iterator &it) const override;
 			int filter(const Iterator &it) const override;
+			size_t size() const override;
+			void key(const char *key) override;
+			QueryStatistics::Kind kind() const noexcept override;
 
 		};
 
@@ -116,18 +207,27 @@
 		protected:
 
 			/// @brief The selected records.
-			std::vector<const size_t *> records;
+			std::vector<Row> records;
+
+			/// @brief How the records were selected.
+			QueryStatistics::Kind selection;
 
 		public:
-			CustomKeyHandler() = default;
+			CustomKeyHandler(QueryStatistics::Kind selection = QueryStatistics::Other) : selection{selection} {
+			}
 
 			void push_back(const Iterator &it);
 
-			const size_t * rowptr(const Iterator &it) const override;
+			/// @brief Select record from pointer.
+			inline void push_back(const Row &row) {
+				records.push_back(row);
+			}
+
+			Row rowptr(const Iterator &it) const override;
 			int filter(const Iterator &it) const override;
 			size_t size() const override;
 			void key(const char *key) override;
-
+			QueryStatistics::Kind kind() const noexcept override;
 
 		};
 
@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare posting lists.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/datastore/row.h>
+ #include <functional>
+ #include <vector>
+
+ namespace Udjat {
+
+ 	namespace DataStore {
+
+		class Bitmap;
+
+		/// @brief Sorted list of record ids.
+		/// @details Record ids (offsets on row stores, row numbers on columnar stores) follow
+		/// the primary index order, the lists can be merged without touching the rows.
+		class UDJAT_PRIVATE Postings {
+		private:
+
+			/// @brief The record ids, sorted.
+			std::vector<size_t> records;
+
+		public:
+			Postings() = default;
+
+			/// @brief Build list from index entries.
+			/// @param entries The index entries (record ids on index order).
+			/// @param count The number of entries.
+			Postings(const size_t *entries, size_t count);
+
+			/// @brief Build list from bitmap.
+			Postings(const File &file, const Bitmap &bitmap);
+
+			/// @brief Get the record id for a primary index row.
+			static size_t record(const File &file, size_t row);
+
+			/// @brief Keep only the records on both lists.
+			/// @details Gallops over the larger list, the cost depends mostly on the smaller one.
+			Postings & operator&=(const Postings &postings);
+
+			/// @brief Merge the records of both lists.
+			Postings & operator|=(const Postings &postings);
+
+			inline size_t size() const noexcept {
+				return records.size();
+			}
+
+			inline bool empty() const noexcept {
+				return records.empty();
+			}
+
+			/// @brief Call method for each selected row.
+			void for_each(const File &file, const std::function<void(const Row &row)> &method) const;
+
+		};
+
+ 	}
+
+ }
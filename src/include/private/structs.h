@@ -33,12 +33,20 @@
 		struct Header {
 			time_t updated;			///< @brief Timestamp of the last update.
 			time_t last_modified;
+			uint64_t generation;	///< @brief Store generation, unique for each build (build time and a per process nonce).
 			size_t primary_offset;	///< @brief Offset for the beginning of the primary index.
 			size_t columns;			///< @brief Number of columns.
+			size_t columnar;		///< @brief Offset of the column array list, 0 for row stores.
+			size_t dictionaries;	///< @brief Offset of the per column dictionary list, 0 if none.
+			size_t symbols;			///< @brief Offset of the per column symbol table list, 0 if none.
 			struct {
 				size_t count;		///< @brief Count of secondary indexes.
 				size_t offset;
 			} indexes;
+			struct {
+				size_t count;		///< @brief Count of data sections.
+				size_t offset;
+			} sections;
 		};
 		#pragma pack()
 
@@ -50,6 +58,57 @@
 		};
 		#pragma pack()
 
+		#pragma pack(1)
+		/// @brief Data section list item.
+		struct Section {
+			enum Type : uint16_t {
+				ApiCall = 1,		///< @brief Private data built for an api-call.
+				Composite = 2,		///< @brief Composite (multi-column) index.
+				Bitmap = 3,			///< @brief Bitmap index, the id is the column.
+			};
+			uint16_t type;			///< @brief Section type.
+			uint16_t id;			///< @brief Section owner (api-call or composite index id).
+			size_t offset;			///< @brief Offset for section data.
+		};
+		#pragma pack()
+
+		#pragma pack(1)
+		/// @brief Composite index section.
+		/// @details Followed by the key column ids (uint16_t) and the index elements.
+		struct CompositeIndex {
+			size_t name;			///< @brief Offset of the index name.
+			uint16_t columns;		///< @brief Number of key columns.
+		};
+		#pragma pack()
+
+		#pragma pack(1)
+		/// @brief Symbol table for compressed strings.
+		/// @details Compressed strings are symbol codes ended by 0, code 255 is followed by a literal byte.
+		struct SymbolTable {
+			uint8_t length[256];	///< @brief Length of each symbol.
+			char symbol[256][8];	///< @brief Symbol text.
+		};
+		#pragma pack()
+
+		#pragma pack(1)
+		/// @brief Bitmap index value.
+		/// @details The bitmap index section is the count of values followed by the values.
+		struct BitmapValue {
+			size_t record;			///< @brief Record id of the first row with this value.
+			size_t offset;			///< @brief Offset of the bitmap.
+		};
+		#pragma pack()
+
+		#pragma pack(1)
+		/// @brief Bitmap container, one for each block of 65536 rows with selected rows.
+		/// @details The bitmap is the count of containers followed by the containers.
+		struct BitmapContainer {
+			uint32_t key;			///< @brief Block number (row >> 16).
+			uint32_t cardinality;	///< @brief Number of selected rows.
+			size_t offset;			///< @brief Sorted uint16_t rows, or 1024 uint64_t words if cardinality > 4096.
+		};
+		#pragma pack()
+
 	}
 
  }
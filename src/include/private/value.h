@@ -35,10 +35,10 @@
 		private:
 			std::shared_ptr<File> file;
 			std::shared_ptr<Abstract::Column> col;
-			const size_t *rowptr;
+			Row rowptr;
 
 		public:
-			Value(std::shared_ptr<File> f, std::shared_ptr<Abstract::Column> c, const size_t *r)
+			Value(std::shared_ptr<File> f, std::shared_ptr<Abstract::Column> c, const Row &r)
 				: file{f}, col{c}, rowptr{r} {
 			}
 
@@ -25,7 +25,12 @@
  #include <udjat/defs.h>
  #include <udjat/tools/converters.h>
  #include <udjat/tools/datastore/deduplicator.h>
+ #include <udjat/tools/datastore/row.h>
  #include <udjat/tools/value.h>
+ #include <cstring>
+ #include <functional>
+ #include <utility>
+ #include <vector>
 
  namespace Udjat {
 
@@ -46,6 +51,9 @@
 
 				Type type = Value;
 
+				/// @brief Has this column a bitmap index?
+				bool bitmap_index = false;
+
 				struct {
 					uint8_t length = 0;		///< @brief Length of the output string.
 					char	leftchar = ' ';	///< @brief Char to fill.
@@ -55,7 +63,13 @@
 				const char *cname;
 				size_t index;
 
-				virtual std::string to_string(std::shared_ptr<File> file, size_t offset) const;
+				/// @brief Three-way comparison of inline values.
+				template <typename T>
+				static inline int compare(const T lhs, const T rhs) noexcept {
+					return (lhs < rhs) ? -1 : ((rhs < lhs) ? 1 : 0);
+				}
+
+				virtual std::string to_string(const std::shared_ptr<File> &file, size_t offset) const;
 
 				/// @brief Compare two values.
 				/// @see std::less
@@ -66,6 +80,22 @@
 				virtual std::string to_string(const void *datablock) const;
 
 			public:
+
+				/// @brief Contents of the row slot.
+				enum Slot : uint8_t {
+					Offset,		///< @brief Offset of the data (or dictionary code).
+					Signed,		///< @brief Signed integer value (sign extended).
+					Unsigned,	///< @brief Unsigned integer value.
+					Real,		///< @brief Floating point value (bits of the double).
+				};
+
+				/// @brief Search key, converted once for the column type.
+				struct Key {
+					std::string text;		///< @brief The key text (for string comparisons).
+					uint64_t value = 0;		///< @brief The converted key (for inline comparisons).
+					bool prefix = true;		///< @brief Match the text as a prefix of the value (false for range bounds).
+				};
+
 				Column(const XML::Node &node,size_t index);
 
 				bool operator==(const char *n) const {
@@ -86,14 +116,19 @@
 					return type == Index;
 				}
 
+				/// @brief Has this column a bitmap index?
+				inline bool bitmap() const noexcept {
+					return bitmap_index;
+				}
+
 				/// @brief Is this column formatted?
 				inline bool formatted() const noexcept {
 					return format.length != 0 && format.leftchar != 0;
 				}
 
 				/// @brief Get column offset.
-				inline size_t offset(const size_t *rowptr) const noexcept {
-					return rowptr[index];
+				inline size_t offset(const Row &row) const noexcept {
+					return row[index];
 				}
 
 				/// @brief Get the size of data-block for this column.
@@ -106,25 +141,44 @@
 				/// @return Offset of the stored data.
 				virtual size_t save(Deduplicator &destination, const char *text) const = 0;
 
+				/// @brief Get the contents of the row slot for this column.
+				virtual Slot slot() const noexcept;
+
+				/// @brief Convert text to the row slot value (only for inline values).
+				/// @return The value as stored on the row slot.
+				virtual size_t convert(const char *text) const;
+
 				/// @brief Load and compare two values, used while loading.
 				/// @param file The file being loaded.
 				/// @return True if loffset < roffset.
-				virtual bool less(std::shared_ptr<File> file, const size_t *lrow, const size_t *rrow) const;
+				virtual bool less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const;
+
+				/// @brief Convert search key, call it once and compare the rows with the result.
+				/// @param text The search key.
+				/// @return The search key converted for binary comparisons.
+				virtual Key parse_key(const char *text) const;
+
+				/// @brief Compare column with search key.
+				/// @param key The search key (from parse_key).
+				/// @return Result of test (<0 if the column value is lower than the key, 0 if equal, >0 if greater).
+				virtual int comp(const std::shared_ptr<File> &file, const Row &row, const Key &key) const;
 
 				/// @brief Compare column with string.
 				/// @return Result of test (strcasecmp)
-				virtual int comp(std::shared_ptr<File> file, const size_t *row, const char *key) const;
+				inline int comp(const std::shared_ptr<File> &file, const Row &row, const char *key) const {
+					return comp(file,row,parse_key(key));
+				}
 
 				/// @brief Format string.
 				/// @param str String to format.
 				/// @return str
 				const std::string & apply_layout(std::string &str) const;
 
-				virtual std::string to_string(std::shared_ptr<File> file, const size_t *row) const;
+				virtual std::string to_string(const std::shared_ptr<File> &file, const Row &row) const;
 
-				void get(std::shared_ptr<File> file, const size_t *row, Udjat::Value &value, Udjat::Value::Type type) const;
+				void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value, Udjat::Value::Type type) const;
 
-				virtual void get(std::shared_ptr<File> file, const size_t *row, Udjat::Value &value) const;
+				virtual void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const;
 
 			};
 
@@ -171,10 +225,11 @@
 			};
 
 			size_t save(Deduplicator &store, const char *text) const override;
-			int comp(std::shared_ptr<File> file, const size_t *row, const char *key) const override;
-			bool less(std::shared_ptr<File> file, const size_t *lrow, const size_t *rrow) const override;
-			std::string to_string(std::shared_ptr<File> file, const size_t *row) const;
-			void get(std::shared_ptr<File> file, const size_t *row, Udjat::Value &value) const override;
+			Slot slot() const noexcept override;
+			size_t convert(const char *text) const override;
+			bool less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const override;
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const;
+			void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const override;
 
 		};
 
@@ -189,10 +244,75 @@
 			};
 
 			size_t save(Deduplicator &store, const char *text) const override;
-			int comp(std::shared_ptr<File> file, const size_t *row, const char *key) const override;
-			bool less(std::shared_ptr<File> file, const size_t *lrow, const size_t *rrow) const override;
-			std::string to_string(std::shared_ptr<File> file, const size_t *row) const;
-			void get(std::shared_ptr<File> file, const size_t *row, Udjat::Value &value) const override;
+			Slot slot() const noexcept override;
+			size_t convert(const char *text) const override;
+			bool less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const override;
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const;
+			void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const override;
+
+		};
+
+		/// @brief 64 bits integer, inline if it fits on the row slot.
+		template <>
+		class UDJAT_API Column<int64_t> : public Abstract::Column {
+		protected:
+
+			/// @brief Convert text to value.
+			virtual int64_t parse(const char *text) const;
+
+			/// @brief Get value from row.
+			int64_t value(const std::shared_ptr<File> &file, const Row &row) const;
+
+		public:
+			Column(const XML::Node &node,size_t index) : Abstract::Column{node,index} {
+			}
+
+			size_t length() const noexcept override {
+				return sizeof(int64_t);
+			};
+
+			size_t save(Deduplicator &store, const char *text) const override;
+			Slot slot() const noexcept override;
+			size_t convert(const char *text) const override;
+			Key parse_key(const char *text) const override;
+			int comp(const std::shared_ptr<File> &file, const Row &row, const Key &key) const override;
+			bool less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const override;
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const override;
+			void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const override;
+
+		};
+
+		/// @brief Double precision floating point, inline if it fits on the row slot.
+		template <>
+		class UDJAT_API Column<double> : public Abstract::Column {
+		protected:
+
+			/// @brief Get value from row.
+			double value(const std::shared_ptr<File> &file, const Row &row) const;
+
+		public:
+			Column(const XML::Node &node,size_t index) : Abstract::Column{node,index} {
+			}
+
+			size_t length() const noexcept override {
+				return sizeof(double);
+			};
+
+			/// @brief Get the value from an inline row slot.
+			static inline double value(size_t slot) noexcept {
+				double value;
+				memcpy(&value,&slot,sizeof(value));
+				return value;
+			}
+
+			size_t save(Deduplicator &store, const char *text) const override;
+			Slot slot() const noexcept override;
+			size_t convert(const char *text) const override;
+			Key parse_key(const char *text) const override;
+			int comp(const std::shared_ptr<File> &file, const Row &row, const Key &key) const override;
+			bool less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const override;
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const override;
+			void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const override;
 
 		};
 
@@ -206,15 +326,33 @@
 				return sizeof(uint32_t);
 			};
 
-			std::string to_string(std::shared_ptr<File> file, const size_t *row) const;
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const;
 			size_t save(Deduplicator &store, const char *text) const override;
-			void get(std::shared_ptr<File> file, const size_t *row, Udjat::Value &value) const override;
+			size_t convert(const char *text) const override;
+			void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const override;
 
 		};
 
 
 		template <>
 		class UDJAT_API Column<std::string> : public Abstract::Column {
+		public:
+			/// @brief Dictionary encoding.
+			enum Encoding : uint8_t {
+				Plain,			///< @brief Rows store the string offsets.
+				Sequential,		///< @brief Rows store dictionary codes in load order.
+				Sorted,			///< @brief Rows store order preserving (case-folded) dictionary codes.
+			};
+
+		private:
+			Encoding encoding = Plain;
+
+			/// @brief Are the strings compressed?
+			bool compression = false;
+
+			/// @brief Get string from offset, decompress it if necessary.
+			std::string text(const std::shared_ptr<File> &file, size_t offset) const;
+
 		protected:
 			bool less(const void *lhs, const void *rhs) const override {
 				return strcasecmp((const char *) lhs, (const char *) rhs) < 0;
@@ -224,8 +362,32 @@
 				return std::string{datablock ? (const char *) datablock : ""};
 			}
 
+			/// @brief Get the string offset from the column slot.
+			/// @param value The slot value (dictionary code on encoded columns).
+			/// @return The offset of the string, 0 if empty.
+			size_t heap(const std::shared_ptr<File> &file, size_t value) const;
+
+			/// @brief Get string from the column slot, decoded and decompressed.
+			std::string to_string(const std::shared_ptr<File> &file, size_t value) const override;
+
 		public:
-			Column(const XML::Node &node,size_t index) : Abstract::Column{node,index} {
+			Column(const XML::Node &node,size_t index);
+
+			/// @brief Is this column dictionary encoded?
+			/// @return true if the rows store dictionary codes instead of string offsets.
+			inline bool dictionary() const noexcept {
+				return encoding != Plain;
+			}
+
+			/// @brief Are the strings compressed with a symbol table?
+			inline bool compressed() const noexcept {
+				return compression;
+			}
+
+			/// @brief Are the dictionary codes ordered as the strings?
+			/// @return true if code comparisons are the same as case insensitive string comparisons.
+			inline bool sorted() const noexcept {
+				return encoding == Sorted;
 			}
 
 			size_t length() const noexcept override {
@@ -236,6 +398,22 @@
 				return store.insert(text,strlen(text)+1);
 			}
 
+			bool less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const override;
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const override;
+
+			/// @brief Test every dictionary entry.
+			/// @param file The mapped file.
+			/// @param test The test for dictionary values.
+			/// @return Selected codes, selected[code] is true if the value has passed the test.
+			std::vector<bool> select(const std::shared_ptr<File> &file, const std::function<bool(const char *value)> &test) const;
+
+			/// @brief Get the range of sorted dictionary codes with a prefix.
+			/// @param file The mapped file.
+			/// @param key The prefix to search for (case insensitive).
+			/// @param prefix If false get the codes of the values equal to key (for range bounds).
+			/// @return The first code with the prefix and the code after the last one.
+			std::pair<size_t,size_t> codes(const std::shared_ptr<File> &file, const char *key, bool prefix = true) const;
+
 		};
 
 	}
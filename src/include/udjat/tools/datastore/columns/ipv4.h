@@ -49,14 +49,15 @@
 				return sizeof(in_addr);
 			};
 
-			inline size_t value(const size_t *row) const {
+			inline size_t value(const Row &row) const {
 				return row[index];
 			}
 
 			size_t save(Deduplicator &store, const char *text) const override;
-			int comp(std::shared_ptr<File> file, const size_t *row, const char *key) const override;
-			bool less(std::shared_ptr<File> file, const size_t *lrow, const size_t *rrow) const override;
-			std::string to_string(std::shared_ptr<File> file, const size_t *row) const;
+			Slot slot() const noexcept override;
+			size_t convert(const char *text) const override;
+			bool less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const override;
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const;
 
 		};
 	}
@@ -0,0 +1,50 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare timestamp column.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/timestamp.h>
+
+ namespace Udjat {
+
+	namespace DataStore {
+
+		/// @brief Timestamp column, ISO-8601 (or epoch) values are stored as seconds since epoch (UTC).
+		template <>
+		class UDJAT_API Column<TimeStamp> : public Column<int64_t> {
+		protected:
+			int64_t parse(const char *text) const override;
+
+		public:
+			Column(const XML::Node &node,size_t index) : Column<int64_t>{node,index} {
+			}
+
+			std::string to_string(const std::shared_ptr<File> &file, const Row &row) const override;
+			void get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const override;
+
+		};
+	}
+
+ }
+
@@ -26,6 +26,8 @@
  #include <udjat/tools/datastore/column.h>
  #include <udjat/tools/datastore/iterator.h>
  #include <udjat/tools/datastore/query.h>
+ #include <udjat/tools/datastore/snapshot.h>
+ #include <udjat/tools/datastore/statistics.h>
  #include <udjat/tools/xml.h>
  #include <udjat/tools/timestamp.h>
  #include <udjat/tools/value.h>
@@ -35,6 +37,8 @@
  #include <udjat/tools/request.h>
  #include <vector>
  #include <iterator>
+ #include <deque>
+ #include <mutex>
 
  namespace Udjat {
 
@@ -60,8 +64,11 @@
 
 			time_t expires;
 
+			/// @brief Store columns as dense arrays instead of row records?
+			bool columnar_layout = false;
+
 			/// @brief The current file holding the real data.
-			std::shared_ptr<File> active_file;
+			Snapshot active_file;
 
 			/// @brief The data columns.
 			std::vector<std::shared_ptr<Abstract::Column>> cols;
@@ -78,9 +85,62 @@
 			std::vector<Alias> aliases;
 			std::vector<std::shared_ptr<Query>> queries;
 
+			/// @brief Warm-up of a new generation, before it goes live.
+			struct {
+				bool enabled = true;			///< @brief Fault in the indexes before activating a new generation?
+				size_t queries = 0;				///< @brief Number of recent searches to replay.
+				std::mutex guard;				///< @brief Protect the recent searches.
+				std::deque<std::string> recent;	///< @brief The recent searches, newest first.
+			} warmup;
+
+			/// @brief Memory policy for the mapped store.
+			struct {
+				bool lock = false;					///< @brief Lock the store in memory (mlock)?
+				bool huge_pages = false;			///< @brief Use transparent huge pages on the indexes?
+				File::Access access = File::Normal;	///< @brief Access pattern (madvise).
+			} memory;
+
+			/// @brief Performance counters of the last builds.
+			struct {
+				size_t length = 8;						///< @brief Number of builds to keep.
+				mutable std::mutex guard;				///< @brief Protect the history.
+				std::deque<LoadStatistics> builds;		///< @brief The last builds, newest first.
+			} history;
+
+			/// @brief Query latency histograms.
+			mutable QueryStatistics latency;
+
+			/// @brief The activated store generations, to count the ones still mapped.
+			struct {
+				mutable std::mutex guard;
+				mutable std::vector<std::weak_ptr<File>> files;
+			} generations;
+
+			/// @brief Path of the store shared with other processes, empty for a private store.
+			const char *shared_path;
+
+			/// @brief Build the shared store or wait for the process building it.
+			/// @return The published store, nullptr if it is the active generation.
+			std::shared_ptr<File> shared();
+
+			/// @brief Fault in the indexes and replay the recent searches.
+			/// @param file The new generation, not yet active.
+			void prefetch(std::shared_ptr<File> file);
+
 		protected:
 			const char *filespec;
 
+		public:
+
+			/// @brief Composite (multi-column) index.
+			struct Composite {
+				const char *name;					///< @brief Index name, used on path.
+				std::vector<uint16_t> columns;		///< @brief Key columns, in order.
+			};
+
+		private:
+			std::vector<Composite> composites;
+
 		public:
 
 			/// @brief Build container from XML node.
@@ -106,6 +166,12 @@
 				return (bool) active_file;
 			}
 
+			/// @brief Get the active store generation.
+			/// @details Lock free, the generation stays mapped while the returned pointer (or an iterator using it) exists.
+			inline std::shared_ptr<File> snapshot() const noexcept {
+				return active_file.get();
+			}
+
 			virtual void state(const State state);
 
 			/// @brief Get the number of entries in the container.
@@ -123,9 +189,38 @@
 				return cols;
 			}
 
+			/// @brief Is the store using the columnar layout?
+			inline bool columnar() const noexcept {
+				return columnar_layout;
+			}
+
+			/// @brief The composite indexes defined for the container.
+			inline const std::vector<Composite> & composite_indexes() const noexcept {
+				return composites;
+			}
+
+			/// @brief The api-calls defined for the container.
+			inline const std::vector<std::shared_ptr<Query>> & api_calls() const noexcept {
+				return queries;
+			}
+
 			/// @brief Load source files, rebuild work file.
 			void load();
 
+			/// @brief Record the performance counters of a build.
+			void statistics(const LoadStatistics &stats);
+
+			/// @brief Get the performance counters of the last builds, newest first.
+			std::deque<LoadStatistics> statistics() const;
+
+			/// @brief Get the memory used by the active store generation.
+			MemoryStatistics memory_usage() const;
+
+			/// @brief Get the query latency histograms.
+			inline QueryStatistics & query_statistics() const noexcept {
+				return latency;
+			}
+
 			/// @brief Get container by request.
 			/// @param name The name of required datastore.
 			/// @return nullptr if not found.
@@ -140,6 +235,19 @@
 			/// @param request the request.
 			Iterator find(Request &request);
 
+			/// @brief Batch lookup, get rows for all keys on the request 'keys' argument.
+			/// @param request The request, path should be 'batch' or '<column>/batch'.
+			/// @param response The response table, the first column is the search key.
+			/// @return false if the request is not a batch lookup.
+			bool batch(const Request &request, Response::Table &response) const;
+
+			/// @brief Aggregate rows, the path should be '<column>/count', '<column>/distinct' or 'groupby/<column>[/<column>...]'.
+			/// @details Uses the request 'filter' argument to select the rows.
+			/// @param request The request.
+			/// @param response The response table, the group values and the row count.
+			/// @return false if the request is not an aggregation.
+			bool aggregate(const Request &request, Response::Table &response) const;
+
 		};
 
 	}
@@ -66,6 +66,10 @@
 
 			std::unordered_set<Block, Block::HashFunction> blocks;
 
+			size_t lookups = 0;		///< @brief Number of inserted blocks.
+			size_t hits = 0;		///< @brief Number of inserted blocks already on file.
+			size_t reused = 0;		///< @brief Length of the inserted blocks already on file.
+
 		public:
 
 			/// @brief Construct a data storage to file.
@@ -83,6 +87,26 @@
 				return insert(str,strlen(str)+1);
 			}
 
+			/// @brief Get the number of inserted blocks.
+			inline size_t inserted() const noexcept {
+				return lookups;
+			}
+
+			/// @brief Get the number of inserted blocks found on file.
+			inline size_t found() const noexcept {
+				return hits;
+			}
+
+			/// @brief Get the bytes not written because the block was already on file.
+			inline size_t saved() const noexcept {
+				return reused;
+			}
+
+			/// @brief Get the number of distinct blocks on file.
+			inline size_t size() const noexcept {
+				return blocks.size();
+			}
+
 		};
 
 	}
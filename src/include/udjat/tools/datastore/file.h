@@ -44,8 +44,18 @@
 
 
 		public:
+
+			/// @brief Expected access pattern, for the system read ahead.
+			enum Access : uint8_t {
+				Normal,			///< @brief No hint, the system default.
+				Random,			///< @brief Lookups, don't read ahead.
+				Sequential,		///< @brief Scans, read ahead aggressively.
+			};
+
 			File();
-			File(const char *filename);
+			/// @param filename The file name.
+			/// @param writable If false open an existing file for reading only.
+			File(const char *filename, bool writable = true);
 			~File();
 
 			size_t size();
@@ -71,6 +81,30 @@
 				return (bool) ptr;
 			}
 
+			/// @brief Fault in a block of the mapped file before it is required.
+			/// @param offset The block offset.
+			/// @param length The block length.
+			void prefetch(size_t offset, size_t length) const noexcept;
+
+			/// @brief Set the expected access pattern of a block of the mapped file.
+			/// @param offset The block offset.
+			/// @param length The block length.
+			/// @param access The access pattern.
+			void advise(size_t offset, size_t length, Access access) const noexcept;
+
+			/// @brief Ask for (transparent) huge pages on a block of the mapped file.
+			/// @param offset The block offset.
+			/// @param length The block length.
+			void huge_pages(size_t offset, size_t length) const noexcept;
+
+			/// @brief Lock the mapped file in memory, the pages are released on unmap().
+			/// @return false if the system refused to lock the pages.
+			bool lock() noexcept;
+
+			/// @brief Get the resident part of the mapped file.
+			/// @return The number of bytes on memory pages, 0 if the file is not mapped.
+			size_t resident();
+
 			/// @brief Write data to file.
 			/// @param offset for start.
 			/// @param data The datablock to write.
@@ -26,6 +26,8 @@
  #include <udjat/tools/datastore/file.h>
  #include <udjat/tools/request.h>
  #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/datastore/row.h>
+ #include <udjat/tools/datastore/statistics.h>
  #include <udjat/tools/report.h>
  #include <udjat/tools/value.h>
  #include <memory>
@@ -42,13 +44,14 @@
 			/// @brief The current file holding the real data.
 			const std::shared_ptr<File> file;
 
-			/// @brief The data columns.
-			const std::vector<std::shared_ptr<Abstract::Column>> cols;
+			/// @brief The data columns, borrowed from the container (copying an iterator doesn't copy the column table).
+			/// @note The column table must outlive the iterator, temporaries are rejected by the constructors.
+			const std::vector<std::shared_ptr<Abstract::Column>> &cols;
 
 			/// @brief Selected row (from 0 to the end of file)
 			size_t row = 1;
 
-			const size_t * rowptr() const;
+			Row rowptr() const;
 
 		public:
 			using iterator_category = std::random_access_iterator_tag;
@@ -62,28 +65,41 @@
 
 			/// @brief Build an iterator from path.
 			static Iterator Factory(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, const char *path);
+			static Iterator Factory(const std::shared_ptr<DataStore::File> file, std::vector<std::shared_ptr<DataStore::Abstract::Column>> &&cols, const char *path) = delete;
 
 			/// @brief Build an iterator from request.
 			static Iterator Factory(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, const Request &request);
+			static Iterator Factory(const std::shared_ptr<DataStore::File> file, std::vector<std::shared_ptr<DataStore::Abstract::Column>> &&cols, const Request &request) = delete;
 
 			/// @brief Build an iterator to the entire file.
 			Iterator(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols);
+			Iterator(const std::shared_ptr<DataStore::File> file, std::vector<std::shared_ptr<DataStore::Abstract::Column>> &&cols) = delete;
 
 			/// @brief Build an iterator searching on primary key.
 			Iterator(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, const std::string &key);
+			Iterator(const std::shared_ptr<DataStore::File> file, std::vector<std::shared_ptr<DataStore::Abstract::Column>> &&cols, const std::string &key) = delete;
 
 			/// @brief Build and iterator searching column id.
 			Iterator(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, const uint16_t column_id, const std::string &key);
+			Iterator(const std::shared_ptr<DataStore::File> file, std::vector<std::shared_ptr<DataStore::Abstract::Column>> &&cols, const uint16_t column_id, const std::string &key) = delete;
 
 			/// @brief Build and iterator searching column name.
 			Iterator(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, const std::string &column_name, const std::string &key);
+			Iterator(const std::shared_ptr<DataStore::File> file, std::vector<std::shared_ptr<DataStore::Abstract::Column>> &&cols, const std::string &column_name, const std::string &key) = delete;
 
 			/// @brief Build and iterator searching column name.
 			Iterator(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, std::shared_ptr<Handler> handler);
+			Iterator(const std::shared_ptr<DataStore::File> file, std::vector<std::shared_ptr<DataStore::Abstract::Column>> &&cols, std::shared_ptr<Handler> handler) = delete;
 
 			/// @brief Search using handler.
 			void search();
 
+			/// @brief Keep only the rows matching a filter expression.
+			/// @param expression The filter, predicates as 'column<op>value' (=, !=, <, <=, >, >= or ~ for contains)
+			/// joined by '&' (or ',') and '|', '!' negates the next term and parentheses group terms.
+			/// @param scan If true the iterator has the entire table and the filter can search the column indexes.
+			void filter(const char *expression, bool scan = false);
+
 			/// @brief Is this iterator valid?
 			operator bool() const;
 
@@ -117,6 +133,9 @@
 			/// @brief Get item count.
 			size_t count() const;
 
+			/// @brief Get the query kind, from the search handler.
+			QueryStatistics::Kind kind() const noexcept;
+
 			/// @brief Get primary key.
 			std::string primary_key() const;
 
@@ -135,6 +154,44 @@
 			/// @return true if value was updated.
 			bool get(Udjat::Response::Table &value) const;
 
+			/// @brief Get a page of values from iterator.
+			/// @param value The container to responses.
+			/// @param limit The maximum number of rows, 0 for all; if not 0 adds a '_cursor' column for continuation.
+			/// @return true if value was updated.
+			bool get(Udjat::Response::Table &value, size_t limit) const;
+
+			/// @brief Get values from iterator using the request 'offset', 'limit' and 'cursor' arguments.
+			/// @param request The request with paging arguments.
+			/// @param value The container to responses.
+			/// @return true if value was updated.
+			bool get(const Request &request, Udjat::Response::Table &value) const;
+
+			/// @brief Get rows for a list of keys using the iterator handler.
+			/// @details The keys are sorted and searched with a galloping search starting from
+			/// the previous match, in one pass over the index. Changes the handler search key.
+			/// @param keys The search keys.
+			/// @param value The container to responses, the first column ('_key') is the search key.
+			/// @return true if value was updated.
+			bool batch(std::vector<std::string> &keys, Udjat::Response::Table &value) const;
+
+			/// @brief Count the selected rows grouped by column values.
+			/// @details Consecutive rows with the same values are counted as one run (one pass over
+			/// a column index), large selections are split between threads with a hash table for each.
+			/// Rows with empty strings are ignored.
+			/// @param columns The group columns.
+			/// @param counts If true add the '_count' column with the number of rows on each group.
+			/// @param value The container to responses, one row for each group sorted by the column values.
+			/// @return true if value was updated.
+			bool aggregate(const std::vector<uint16_t> &columns, bool counts, Udjat::Response::Table &value) const;
+
+			/// @brief Get continuation cursor (store generation and row position).
+			std::string cursor() const;
+
+			/// @brief Move to cursor position.
+			/// @param cursor The cursor from a previous page.
+			/// @throw std::system_error if the cursor is invalid or from another store generation.
+			void cursor(const char *cursor);
+
 			bool head(Udjat::Abstract::Response &response) const;
 
 		private:
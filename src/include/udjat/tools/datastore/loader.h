@@ -28,6 +28,7 @@
  #include <udjat/tools/datastore/deduplicator.h>
  #include <udjat/tools/datastore/file.h>
  #include <udjat/tools/datastore/container.h>
+ #include <udjat/tools/datastore/statistics.h>
  #include <string>
  #include <vector>
  #include <sys/types.h>
@@ -44,6 +45,9 @@
 
 				Container &container;
 
+				/// @brief Performance counters of the last build.
+				LoadStatistics stats;
+
 				struct InputFile {
 					std::string name;
 					struct stat st;
@@ -65,6 +69,12 @@
 					/// @param values The column values.
 					virtual void append(std::vector<String> &values) = 0;
 
+					/// @brief Does the context have all the rows it needs?
+					/// @return true to stop reading the current file.
+					virtual bool complete() const {
+						return false;
+					}
+
 				};
 
 				virtual void load_file(Context &context, const char *filename) = 0;
@@ -77,8 +87,12 @@
 					return files.empty();
 				}
 
+				/// @brief Get the modification time of the newest source file.
+				time_t last_modified() const noexcept;
+
 				/// @brief Load sources, return an updated storage.
-				std::shared_ptr<DataStore::File> load();
+				/// @param filename The storage file name, nullptr for a temporary file.
+				std::shared_ptr<DataStore::File> load(const char *filename = nullptr);
 
 			};
 
@@ -39,14 +39,27 @@
 		class UDJAT_API Query  : public Udjat::RequestPath {
 		protected:
 
-			Query(const XML::Node &node) : Udjat::RequestPath{node} {
+			/// @brief The api-call id, identify the data sections built for it.
+			const uint16_t id;
+
+			Query(const XML::Node &node, uint16_t i) : Udjat::RequestPath{node}, id{i} {
 			}
 
+			/// @brief Get the data section built for this api-call.
+			/// @return Offset of the section data or 0 if not found.
+			size_t section(std::shared_ptr<File> file) const;
+
 		public:
 
 			virtual ~Query();
 
-			static std::shared_ptr<Query> Factory(const XML::Node &node, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols);
+			static std::shared_ptr<Query> Factory(const XML::Node &node, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, uint16_t id);
+
+			/// @brief Build api-call private data while loading.
+			/// @param file The file being loaded.
+			/// @param records The offsets of the data records.
+			/// @return Offset of the section data or 0 if the api-call doesnt require one.
+			virtual size_t build(const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, std::shared_ptr<File> file, const std::vector<size_t> &records) const;
 
 			virtual DataStore::Iterator call(const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols,std::shared_ptr<File>, const Request &request) const = 0;
 
@@ -0,0 +1,115 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare row accessor.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <cstdint>
+ #include <cstddef>
+
+ namespace Udjat {
+
+	namespace DataStore {
+
+		class File;
+
+		/// @brief Row accessor, get the column slots from row or columnar stores.
+		class UDJAT_API Row {
+		public:
+
+			#pragma pack(1)
+			/// @brief Column array descriptor (columnar stores).
+			struct Array {
+				size_t offset;		///< @brief Offset of the first value.
+				uint8_t width;		///< @brief Width of each value (1, 2, 4 or 8 bytes).
+			};
+			#pragma pack()
+
+		private:
+
+			const size_t *ptr = nullptr;		///< @brief The row slots (row stores).
+			const uint8_t *base = nullptr;		///< @brief The mapped file (columnar stores).
+			const Array *arrays = nullptr;		///< @brief The column arrays (columnar stores).
+			size_t number = 0;					///< @brief The row number (columnar stores).
+
+		public:
+
+			constexpr Row() {
+			}
+
+			/// @brief Build accessor for row stores.
+			/// @param p Pointer to the row slots.
+			constexpr Row(const size_t *p) : ptr{p} {
+			}
+
+			/// @brief Build accessor for columnar stores.
+			/// @param file The mapped file.
+			/// @param number The row number.
+			Row(const File &file, size_t number);
+
+			/// @brief Build accessor from record id.
+			/// @param file The mapped file.
+			/// @param record The record id (offset on row stores, row number on columnar stores).
+			static Row Factory(const File &file, size_t record);
+
+			/// @brief Is this row valid?
+			inline operator bool() const noexcept {
+				return ptr || arrays;
+			}
+
+			inline bool operator==(const Row &r) const noexcept {
+				return ptr == r.ptr && arrays == r.arrays && number == r.number;
+			}
+
+			/// @brief Get column slot.
+			/// @param column The column index.
+			/// @return The column value (for inline types) or the offset of the data.
+			inline size_t operator[](size_t column) const noexcept {
+
+				if(ptr) {
+					return ptr[column];
+				}
+
+				const Array &array{arrays[column]};
+				const uint8_t *value = base + array.offset + (number * array.width);
+
+				switch(array.width) {
+				case sizeof(uint8_t):
+					return (size_t) *value;
+
+				case sizeof(uint16_t):
+					return (size_t) *((const uint16_t *) value);
+
+				case sizeof(uint32_t):
+					return (size_t) *((const uint32_t *) value);
+
+				}
+
+				return *((const size_t *) value);
+
+			}
+
+		};
+
+	}
+
+ }
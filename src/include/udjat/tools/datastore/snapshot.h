@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declare store generation publisher.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <atomic>
+ #include <memory>
+ #include <mutex>
+
+ namespace Udjat {
+
+	namespace DataStore {
+
+		/// @brief Publish the active store generation without locking the readers.
+		/// @details Two slots, the active one and the one being replaced; readers register on the
+		/// active slot, copy the file pointer and leave. Only the writer waits, for the readers
+		/// still copying from the slot it will replace. The generation is unmapped when the last
+		/// copy of the file pointer is released.
+		class UDJAT_API Snapshot {
+		private:
+
+			struct Slot {
+				std::shared_ptr<File> file;
+				std::atomic<size_t> readers{0};		///< @brief Readers copying the file pointer.
+			};
+
+			mutable Slot slots[2];
+
+			/// @brief The active slot.
+			std::atomic<uint8_t> active{0};
+
+			/// @brief Serialize the writers.
+			std::mutex guard;
+
+			/// @brief Wait for readers leaving the slot.
+			static void wait(const Slot &slot) noexcept;
+
+		public:
+			Snapshot() = default;
+			Snapshot(const Snapshot &) = delete;
+			Snapshot & operator=(const Snapshot &) = delete;
+
+			/// @brief Pin the active generation (lock free).
+			/// @return The active file, empty if not loaded.
+			std::shared_ptr<File> get() const noexcept;
+
+			/// @brief Make a new generation active.
+			/// @param file The new generation.
+			void set(std::shared_ptr<File> file);
+
+			inline operator bool() const noexcept {
+				return (bool) get();
+			}
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,268 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Declare store build and query statistics.
+  */
+
+ #pragma once
+ #include <udjat/defs.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/response.h>
+ #include <atomic>
+ #include <chrono>
+ #include <ctime>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace DataStore {
+
+		class File;
+
+		/// @brief Performance counters of a store build.
+		struct UDJAT_API LoadStatistics {
+
+			time_t started = 0;				///< @brief When the build has started.
+
+			/// @brief Counters of a build phase.
+			struct Phase {
+				const char *name;			///< @brief The phase name.
+				double wall = 0;			///< @brief Elapsed time, in seconds.
+				double cpu = 0;				///< @brief CPU time of the loading thread, in seconds.
+				size_t bytes = 0;			///< @brief Bytes written on the store.
+			};
+
+			std::vector<Phase> phases;
+
+			/// @brief Source files.
+			struct {
+				size_t files = 0;			///< @brief Number of source files.
+				size_t bytes = 0;			///< @brief Length of the source files.
+				size_t rows = 0;			///< @brief Rows read from the source files.
+				double convert = 0;			///< @brief Time converting and deduplicating values, in seconds.
+				double insert = 0;			///< @brief Time inserting on the primary index, in seconds.
+			} sources;
+
+			/// @brief Deduplicator.
+			struct {
+				size_t lookups = 0;			///< @brief Values stored.
+				size_t hits = 0;			///< @brief Values found on the store.
+				size_t blocks = 0;			///< @brief Distinct blocks.
+				size_t saved = 0;			///< @brief Bytes of the values found on the store.
+			} dedup;
+
+			size_t records = 0;				///< @brief Records on the store.
+			size_t length = 0;				///< @brief Length of the store.
+			size_t process_peak_rss = 0;	///< @brief Peak resident set size over the process lifetime (not this build), in KB.
+
+			/// @brief Measure a build phase, from construction to destruction.
+			/// @details Timers with the same phase name are added together.
+			class UDJAT_API Timer {
+			private:
+				LoadStatistics &stats;
+				File &file;
+				const char *name;
+				std::chrono::steady_clock::time_point wall;
+				double cpu;
+				size_t length;
+
+			public:
+				Timer(LoadStatistics &stats, File &file, const char *name);
+				~Timer();
+			};
+
+			/// @brief Get the time spent on a phase.
+			/// @return The phase counters, nullptr if the phase was not executed.
+			const Phase * phase(const char *name) const noexcept;
+
+			/// @brief Get the counters.
+			Udjat::Value & get(Udjat::Value &value) const;
+
+		};
+
+		/// @brief Memory used by a container.
+		struct UDJAT_API MemoryStatistics {
+
+			/// @brief An index section.
+			struct Section {
+				const char *type;		///< @brief Section type ('indexes', 'bitmaps' or 'composites').
+				std::string name;		///< @brief Column or composite index name.
+				size_t length = 0;
+			};
+
+			size_t length = 0;				///< @brief Length of the mapped store.
+			size_t resident = 0;			///< @brief Resident part of the mapped store.
+			size_t header = 0;				///< @brief Header and source list.
+			size_t symbols = 0;				///< @brief Symbol tables of the compressed columns.
+			size_t strings = 0;				///< @brief String heap.
+			size_t dictionaries = 0;		///< @brief Dictionaries of the encoded columns.
+			size_t primary = 0;				///< @brief Rows (or column arrays) on primary key order.
+			std::vector<Section> indexes;	///< @brief Secondary, bitmap and composite indexes.
+			size_t other = 0;				///< @brief Api-call data and section lists.
+			size_t deduplicated = 0;		///< @brief Bytes saved by the deduplicator on the last build.
+			size_t generations = 0;			///< @brief Store generations still mapped.
+			size_t pinned = 0;				///< @brief Replaced generations kept mapped by readers.
+
+			/// @brief Get the counters.
+			Udjat::Value & get(Udjat::Value &value) const;
+
+		};
+
+		/// @brief Query latency histograms and counters.
+		/// @details Each thread records on its own shard, the shards are added together on demand.
+		class UDJAT_API QueryStatistics {
+		public:
+
+			/// @brief Query kind, from the iterator handler.
+			enum Kind : uint8_t {
+				Primary,		///< @brief Primary key search.
+				Index,			///< @brief Column index search.
+				Range,			///< @brief Column index range.
+				Composite,		///< @brief Composite index search.
+				Contains,		///< @brief Substring search.
+				Bitmap,			///< @brief Bitmap index expression.
+				Scan,			///< @brief Scan of a non indexed column.
+				Filter,			///< @brief Filter expression.
+				Row,			///< @brief Row number.
+				NetV4,			///< @brief 'netv4' api-call.
+				IPv4Range,		///< @brief 'ipv4-range' api-call.
+				Batch,			///< @brief Batch lookup.
+				Aggregate,		///< @brief Aggregation.
+				Other,			///< @brief Anything else.
+				Kinds			///< @brief Number of query kinds.
+			};
+
+			static const char * to_string(const Kind kind) noexcept;
+
+			/// @brief Counters of a query kind, the times are in microseconds.
+			struct Summary {
+				Kind kind;
+				size_t count = 0;		///< @brief Number of queries.
+				size_t rows = 0;		///< @brief Rows returned.
+				size_t bytes = 0;		///< @brief Bytes returned.
+				double mean = 0;
+				double p50 = 0;
+				double p90 = 0;
+				double p99 = 0;
+				double p999 = 0;
+				double max = 0;
+				size_t tlb_misses = 0;	///< @brief Data TLB load misses (with the tlb counters enabled).
+			};
+
+			/// @brief Measure a query, from construction to destruction.
+			class UDJAT_API Timer {
+			private:
+				friend class QueryStatistics;
+
+				QueryStatistics &stats;
+				Kind type = Other;
+				std::chrono::steady_clock::time_point started;
+				size_t rows = 0;
+				size_t bytes = 0;
+				bool counting = false;	///< @brief Is the TLB counter running?
+				uint64_t misses = 0;	///< @brief The TLB counter on start.
+				Timer *previous;		///< @brief The outer timer on this thread.
+
+			public:
+				Timer(QueryStatistics &stats);
+				~Timer();
+
+				Timer(const Timer &) = delete;
+				Timer & operator=(const Timer &) = delete;
+
+				/// @brief Set the query kind.
+				inline void kind(const Kind kind) noexcept {
+					type = kind;
+				}
+
+			};
+
+		private:
+
+			/// @brief Histogram buckets, 8 sub buckets for each power of two nanoseconds (12.5% precision).
+			static constexpr size_t Buckets = 312;
+
+			struct Counters {
+				std::atomic<uint64_t> count;
+				std::atomic<uint64_t> rows;
+				std::atomic<uint64_t> bytes;
+				std::atomic<uint64_t> total;	///< @brief Sum of the latencies, in nanoseconds.
+				std::atomic<uint64_t> max;		///< @brief Highest latency, in nanoseconds.
+				std::atomic<uint64_t> tlb;		///< @brief Data TLB load misses.
+				std::atomic<uint64_t> buckets[Buckets];
+			};
+
+			struct Shard {
+				Counters kinds[Kinds];
+			};
+
+			static constexpr size_t Shards = 16;
+			std::atomic<Shard *> shards[Shards];
+
+			/// @brief Get the shard for the current thread, allocate it on first use.
+			Shard & shard();
+
+			/// @brief Count the data TLB misses of the queries?
+			bool tlb = false;
+
+			/// @brief Read the data TLB load misses of the calling thread (perf_event on linux).
+			/// @return false if the counter is not available.
+			static bool tlb_misses(uint64_t &value) noexcept;
+
+		public:
+			QueryStatistics();
+			~QueryStatistics();
+
+			QueryStatistics(const QueryStatistics &) = delete;
+			QueryStatistics & operator=(const QueryStatistics &) = delete;
+
+			/// @brief Record a query.
+			/// @param kind The query kind.
+			/// @param nanoseconds The query latency.
+			/// @param rows The rows returned.
+			/// @param bytes The bytes returned.
+			/// @param tlb_misses The data TLB load misses.
+			void record(const Kind kind, uint64_t nanoseconds, size_t rows = 0, size_t bytes = 0, uint64_t tlb_misses = 0);
+
+			/// @brief Enable the data TLB miss counters.
+			inline void tlb_counters(bool enable) noexcept {
+				tlb = enable;
+			}
+
+			/// @brief Add to the rows and bytes returned by the query running on this thread.
+			static void served(size_t rows, size_t bytes) noexcept;
+
+			/// @brief Add the shards together.
+			/// @return The counters of the query kinds with at least one query.
+			std::vector<Summary> summary() const;
+
+			/// @brief Get the counters, one child for each query kind.
+			Udjat::Value & get(Udjat::Value &value) const;
+
+			/// @brief Get the counters, one row for each query kind.
+			void get(Udjat::Response::Table &value) const;
+
+		};
+
+	}
+
+ }
@@ -116,6 +116,22 @@
 			value["records"] = size();
 			value["modified"] = TimeStamp{DataStore::Container::last_modified()};
 
+			// Performance counters of the last builds.
+			auto builds{statistics()};
+			if(!builds.empty()) {
+				builds.front().get(value["load"]);
+				Value &items{value["load-history"]};
+				for(size_t ix = 0; ix < builds.size(); ix++) {
+					builds[ix].get(items[std::to_string(ix+1).c_str()]);
+				}
+			}
+
+			// Query latency histograms.
+			query_statistics().get(value["queries"]);
+
+			// Memory used by the store.
+			memory_usage().get(value["memory"]);
+
 		} else {
 
 			value["records"] = 0;
@@ -176,7 +192,9 @@
 		}
 
 		debug("Getting response from container");
+		QueryStatistics::Timer timer{query_statistics()};
 		DataStore::Iterator it = DataStore::Container::find(path);
+		timer.kind(it.kind());
 		if(!it) {
 			return false;
 		}
@@ -195,7 +213,9 @@
 		}
 
 		debug("Getting response from container");
+		QueryStatistics::Timer timer{query_statistics()};
 		DataStore::Iterator it = DataStore::Container::find(path);
+		timer.kind(it.kind());
 		if(!it) {
 			return false;
 		}
@@ -225,7 +245,9 @@
 		}
 
 		debug("Getting response from container");
+		QueryStatistics::Timer timer{query_statistics()};
 		DataStore::Iterator it = DataStore::Container::find(path);
+		timer.kind(it.kind());
 		if(!it) {
 			return false;
 		}
@@ -0,0 +1,297 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements row bitmap.
+  *
+  * On file the bitmaps are split in blocks of 65536 rows, blocks with up to 4096
+  * selected rows are stored as sorted arrays of uint16_t, the others as plain
+  * bitmaps (roaring style).
+  *
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/bitmap.h>
+ #include <private/structs.h>
+ #include <udjat/tools/logger.h>
+ #include <stdexcept>
+ #include <algorithm>
+ #include <bitset>
+ #include <cstring>
+ #include <string>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Max cardinality for array containers.
+	static const size_t array_limit = 4096;
+
+	DataStore::Bitmap::Bitmap(size_t r) : rows{r}, words((r+63)/64,0) {
+	}
+
+	DataStore::Bitmap::Bitmap(const File &file, size_t r, size_t offset) : Bitmap{r} {
+
+		size_t count = file.get<size_t>(offset);
+		const BitmapContainer *container = file.get_ptr<BitmapContainer>(offset+sizeof(size_t));
+
+		for(size_t ix = 0; ix < count; ix++) {
+
+			size_t base = ((size_t) container[ix].key) * block;
+			if(base >= rows) {
+				throw runtime_error("Invalid bitmap container");
+			}
+
+			if(container[ix].cardinality > array_limit) {
+
+				size_t length = std::min(block/64,words.size() - (base/64));
+				memcpy(words.data()+(base/64),file.get_void_ptr(container[ix].offset),length * sizeof(uint64_t));
+
+			} else {
+
+				const uint16_t *values = file.get_ptr<uint16_t>(container[ix].offset);
+				for(size_t value = 0; value < container[ix].cardinality; value++) {
+					size_t row = base + values[value];
+					words[row/64] |= (((uint64_t) 1) << (row%64));
+				}
+
+			}
+
+		}
+
+	}
+
+	size_t DataStore::Bitmap::write(File &file, const std::vector<size_t> &rows) {
+
+		std::vector<BitmapContainer> containers;
+
+		size_t from = 0;
+		while(from < rows.size()) {
+
+			// Get rows on the same block.
+			size_t key = rows[from] / block;
+			size_t to = from;
+			while(to < rows.size() && (rows[to] / block) == key) {
+				to++;
+			}
+
+			BitmapContainer container;
+			memset(&container,0,sizeof(container));
+			container.key = (uint32_t) key;
+			container.cardinality = (uint32_t) (to - from);
+
+			if(container.cardinality > array_limit) {
+
+				std::vector<uint64_t> bits(block/64,0);
+				for(size_t ix = from; ix < to; ix++) {
+					size_t row = rows[ix] % block;
+					bits[row/64] |= (((uint64_t) 1) << (row%64));
+				}
+				container.offset = file.write(bits.data(),bits.size() * sizeof(uint64_t));
+
+			} else {
+
+				std::vector<uint16_t> values;
+				values.reserve(to - from);
+				for(size_t ix = from; ix < to; ix++) {
+					values.push_back((uint16_t) (rows[ix] % block));
+				}
+				container.offset = file.write(values.data(),values.size() * sizeof(uint16_t));
+
+			}
+
+			containers.push_back(container);
+			from = to;
+
+		}
+
+		size_t count = containers.size();
+		size_t offset = file.write(count);
+		file.write(containers.data(),containers.size() * sizeof(BitmapContainer));
+
+		return offset;
+
+	}
+
+	DataStore::Bitmap & DataStore::Bitmap::operator&=(const Bitmap &bitmap) {
+		for(size_t ix = 0; ix < words.size() && ix < bitmap.words.size(); ix++) {
+			words[ix] &= bitmap.words[ix];
+		}
+		return *this;
+	}
+
+	DataStore::Bitmap & DataStore::Bitmap::operator|=(const Bitmap &bitmap) {
+		for(size_t ix = 0; ix < words.size() && ix < bitmap.words.size(); ix++) {
+			words[ix] |= bitmap.words[ix];
+		}
+		return *this;
+	}
+
+	void DataStore::Bitmap::invert() {
+
+		for(uint64_t &word : words) {
+			word = ~word;
+		}
+
+		// Unselect the bits after the last row.
+		if(rows % 64) {
+			words.back() &= ((((uint64_t) 1) << (rows % 64)) - 1);
+		}
+
+	}
+
+	size_t DataStore::Bitmap::count() const noexcept {
+		size_t rc = 0;
+		for(uint64_t word : words) {
+			rc += std::bitset<64>(word).count();
+		}
+		return rc;
+	}
+
+	void DataStore::Bitmap::for_each(const std::function<void(size_t row)> &method) const {
+
+		for(size_t ix = 0; ix < words.size(); ix++) {
+			uint64_t word = words[ix];
+			while(word) {
+				method((ix * 64) + __builtin_ctzll(word));
+				word &= (word - 1);
+			}
+		}
+
+	}
+
+	/// @brief Get rows with value on column (case insensitive on strings, by value on numbers).
+	static DataStore::Bitmap select(std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, size_t rows, const std::string &name, const std::string &value) {
+
+		for(size_t column = 0; column < cols.size(); column++) {
+
+			if(strcasecmp(cols[column]->name(),name.c_str())) {
+				continue;
+			}
+
+			if(!cols[column]->bitmap()) {
+				throw runtime_error(Logger::String{"Column '",name.c_str(),"' has no bitmap index"});
+			}
+
+			const DataStore::Header &header{file->get<DataStore::Header>(0)};
+			const DataStore::Section *section{file->get_ptr<DataStore::Section>(header.sections.offset)};
+
+			for(size_t ix = 0; ix < header.sections.count; ix++) {
+
+				if(section[ix].type == DataStore::Section::Bitmap && section[ix].id == column) {
+
+					size_t count = file->get<size_t>(section[ix].offset);
+					const DataStore::BitmapValue *values = file->get_ptr<DataStore::BitmapValue>(section[ix].offset+sizeof(size_t));
+
+					// Compare with the column rules, '080' is 80 on numeric columns.
+					DataStore::Abstract::Column::Key key{cols[column]->parse_key(value.c_str())};
+					key.prefix = false;
+
+					// Values are stored as loaded, merge every case variant.
+					DataStore::Bitmap result{rows};
+					for(size_t v = 0; v < count; v++) {
+						if(!cols[column]->comp(file,DataStore::Row::Factory(*file,values[v].record),key)) {
+							result |= DataStore::Bitmap{*file,rows,values[v].offset};
+						}
+					}
+
+					return result;
+				}
+
+			}
+
+			// No bitmap section for this column.
+			return DataStore::Bitmap{rows};
+
+		}
+
+		throw runtime_error(Logger::String{"Unexpected column '",name.c_str(),"'"});
+
+	}
+
+	DataStore::Bitmap DataStore::Bitmap::Factory(std::shared_ptr<File> file, const std::vector<std::shared_ptr<Abstract::Column>> &cols, const char *expression) {
+
+		const Header &header{file->get<Header>(0)};
+		size_t rows = file->get<size_t>(header.primary_offset);
+
+		// Split expression.
+		std::vector<std::string> tokens;
+		while(expression && *expression) {
+			const char *ptr = strchr(expression,'/');
+			if(!ptr) {
+				tokens.emplace_back(expression);
+				break;
+			}
+			tokens.emplace_back(expression,(size_t) (ptr-expression));
+			expression = ptr+1;
+		}
+
+		Bitmap result{rows};
+		bool conjunction = false;
+
+		size_t ix = 0;
+		do {
+
+			bool negate = false;
+			while(ix < tokens.size() && !strcasecmp(tokens[ix].c_str(),"not")) {
+				negate = !negate;
+				ix++;
+			}
+
+			if(ix+1 >= tokens.size()) {
+				throw runtime_error("Incomplete bitmap expression, expecting 'column/value'");
+			}
+
+			Bitmap term{select(file,cols,rows,tokens[ix],tokens[ix+1])};
+			ix += 2;
+
+			if(negate) {
+				term.invert();
+			}
+
+			if(conjunction) {
+				result &= term;
+			} else {
+				result |= term;
+			}
+
+			if(ix < tokens.size()) {
+
+				if(!strcasecmp(tokens[ix].c_str(),"and")) {
+					conjunction = true;
+				} else if(!strcasecmp(tokens[ix].c_str(),"or")) {
+					conjunction = false;
+				} else {
+					throw runtime_error(Logger::String{"Unexpected '",tokens[ix].c_str(),"' on bitmap expression, expecting 'and' or 'or'"});
+				}
+
+				if(++ix >= tokens.size()) {
+					throw runtime_error("Incomplete bitmap expression, expecting 'column/value'");
+				}
+
+			}
+
+		} while(ix < tokens.size());
+
+		return result;
+
+	}
+
+ }
@@ -43,6 +43,7 @@
 			type = Index;
 		} else {
 			type = Value;
+			bitmap_index = !strcasecmp(node.attribute("index").as_string(""),"bitmap");
 		}
 
 		format.length = (uint8_t) node.attribute("length").as_uint(format.length);
@@ -68,11 +69,56 @@
 		return str;
 	}
 
-	int DataStore::Abstract::Column::comp(std::shared_ptr<File> file, const size_t *row, const char *key) const {
-		return strncasecmp(to_string(file,row).c_str(),key,strlen(key));
+	DataStore::Abstract::Column::Slot DataStore::Abstract::Column::slot() const noexcept {
+		return Offset;
 	}
 
-	std::string DataStore::Abstract::Column::to_string(std::shared_ptr<File> file, size_t offset) const {
+	size_t DataStore::Abstract::Column::convert(const char *) const {
+		throw logic_error(Logger::String{"Column '",name(),"' has no inline values"});
+	}
+
+	DataStore::Abstract::Column::Key DataStore::Abstract::Column::parse_key(const char *text) const {
+
+		Key key;
+		key.text = text;
+
+		if(slot() != Offset) {
+			key.value = (uint64_t) convert(text);
+		}
+
+		return key;
+	}
+
+	int DataStore::Abstract::Column::comp(const std::shared_ptr<File> &file, const Row &row, const Key &key) const {
+
+		switch(slot()) {
+		case Signed:
+			return compare((int64_t) row[index],(int64_t) key.value);
+
+		case Unsigned:
+			return compare((uint64_t) row[index],key.value);
+
+		case Real:
+			{
+				double lhs, rhs;
+				size_t value = row[index];
+				memcpy(&lhs,&value,sizeof(lhs));
+				memcpy(&rhs,&key.value,sizeof(rhs));
+				return compare(lhs,rhs);
+			}
+
+		default:
+			break;
+		}
+
+		if(key.prefix) {
+			return strncasecmp(to_string(file,row).c_str(),key.text.c_str(),key.text.size());
+		}
+
+		return strcasecmp(to_string(file,row).c_str(),key.text.c_str());
+	}
+
+	std::string DataStore::Abstract::Column::to_string(const std::shared_ptr<File> &file, size_t offset) const {
 		if(!offset) {
 			return "";
 		}
@@ -82,7 +128,7 @@
 		return file->get_ptr<char>(offset);
 	}
 
-	bool DataStore::Abstract::Column::less(std::shared_ptr<File> file, const size_t *lrow, const size_t *rrow) const {
+	bool DataStore::Abstract::Column::less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const {
 
 		size_t len = length();
 		if(len) {
@@ -103,7 +149,7 @@
 
 	}
 
-	std::string DataStore::Abstract::Column::to_string(std::shared_ptr<File> file, const size_t *row) const {
+	std::string DataStore::Abstract::Column::to_string(const std::shared_ptr<File> &file, const Row &row) const {
 		std::string str{to_string(file,row[index])};
 		if(format.length) {
 			apply_layout(str);
@@ -119,11 +165,11 @@
 		throw logic_error(Logger::String{"Cant call ",__FUNCTION__," with datablock on column '",name(),"'"});
 	}
 
-	void DataStore::Abstract::Column::get(std::shared_ptr<File> file, const size_t *row, Udjat::Value &value, Udjat::Value::Type type) const {
+	void DataStore::Abstract::Column::get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value, Udjat::Value::Type type) const {
 		value[name()].set(to_string(file,row),type);
 	}
 
-	void DataStore::Abstract::Column::get(std::shared_ptr<File> file, const size_t *row, Udjat::Value &value) const {
+	void DataStore::Abstract::Column::get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const {
 		get(file,row,value,Udjat::Value::String);
 	}
 
@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements floating point column.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/logger.h>
+ #include <stdexcept>
+ #include <cstdlib>
+ #include <cstring>
+ #include <string>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Are the values stored on the row slots?
+	static constexpr bool inline_values = (sizeof(double) <= sizeof(size_t));
+
+	static double parse(const char *text) {
+
+		char *end = nullptr;
+		double value = strtod(text,&end);
+
+		while(end && isspace(*end)) {
+			end++;
+		}
+
+		if(end == text || (end && *end)) {
+			throw runtime_error(Logger::String{"Invalid number '",text,"'"});
+		}
+
+		return value;
+	}
+
+	double DataStore::Column<double>::value(const std::shared_ptr<File> &file, const Row &row) const {
+
+		if(inline_values) {
+			return value(row[index]);
+		}
+
+		double value = 0;
+		if(row[index]) {
+			file->read(row[index],&value,sizeof(value));
+		}
+		return value;
+
+	}
+
+	size_t DataStore::Column<double>::save(Deduplicator &store, const char *text) const {
+
+		if(inline_values) {
+			return convert(text);
+		}
+
+		double value{parse(text)};
+		return store.insert(&value,sizeof(value));
+
+	}
+
+	DataStore::Abstract::Column::Slot DataStore::Column<double>::slot() const noexcept {
+		return inline_values ? Real : Offset;
+	}
+
+	size_t DataStore::Column<double>::convert(const char *text) const {
+
+		if(!inline_values) {
+			return Abstract::Column::convert(text);
+		}
+
+		double value{parse(text)};
+		size_t slot = 0;
+		memcpy(&slot,&value,sizeof(value));
+		return slot;
+	}
+
+	DataStore::Abstract::Column::Key DataStore::Column<double>::parse_key(const char *text) const {
+		Key key;
+		key.text = text;
+		double value{parse(text)};
+		memcpy(&key.value,&value,sizeof(value));
+		return key;
+	}
+
+	int DataStore::Column<double>::comp(const std::shared_ptr<File> &file, const Row &row, const Key &key) const {
+		double value;
+		memcpy(&value,&key.value,sizeof(value));
+		return compare(this->value(file,row),value);
+	}
+
+	bool DataStore::Column<double>::less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const {
+		return value(file,lrow) < value(file,rrow);
+	}
+
+	std::string DataStore::Column<double>::to_string(const std::shared_ptr<File> &file, const Row &row) const {
+		char buffer[32];
+		snprintf(buffer,sizeof(buffer),"%.15g",value(file,row));
+		return buffer;
+	}
+
+	void DataStore::Column<double>::get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const {
+		Abstract::Column::get(file,row,value,Udjat::Value::Real);
+	}
+
+ }
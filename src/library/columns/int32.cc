@@ -18,7 +18,7 @@
  */
 
  /**
-  * @brief Implements ipv4 column.
+  * @brief Implements integer columns.
   */
 
  #include <config.h>
@@ -34,60 +34,72 @@
 	// int32_t
 
 	size_t DataStore::Column<int32_t>::save(Deduplicator &, const char *text) const {
-		return (size_t) stoi(text);
+		return convert(text);
 	}
 
-	int DataStore::Column<int32_t>::comp(std::shared_ptr<File>, const size_t *row, const char *key) const {
-		return row[index] - ((size_t) stoi(key));
+	DataStore::Abstract::Column::Slot DataStore::Column<int32_t>::slot() const noexcept {
+		return Signed;
 	}
 
-	bool DataStore::Column<int32_t>::less(std::shared_ptr<File>, const size_t *lrow, const size_t *rrow) const {
-		return lrow[index] < rrow[index];
+	size_t DataStore::Column<int32_t>::convert(const char *text) const {
+		return (size_t) stoi(text);
 	}
 
-	std::string DataStore::Column<int32_t>::to_string(std::shared_ptr<File>, const size_t *row) const {
+	bool DataStore::Column<int32_t>::less(const std::shared_ptr<File> &, const Row &lrow, const Row &rrow) const {
+		return ((int64_t) lrow[index]) < ((int64_t) rrow[index]);
+	}
+
+	std::string DataStore::Column<int32_t>::to_string(const std::shared_ptr<File> &, const Row &row) const {
 		return std::to_string((int32_t) row[index]);
 	}
 
-	void DataStore::Column<int32_t>::get(std::shared_ptr<File>, const size_t *row, Udjat::Value &value) const {
+	void DataStore::Column<int32_t>::get(const std::shared_ptr<File> &, const Row &row, Udjat::Value &value) const {
 		value[name()] = (int32_t) row[index];
 	}
 
 	// uint32_t
 
 	size_t DataStore::Column<uint32_t>::save(Deduplicator &, const char *text) const {
-		return (size_t) stoul(text);
+		return convert(text);
 	}
 
-	int DataStore::Column<uint32_t>::comp(std::shared_ptr<File>, const size_t *row, const char *key) const {
-		return row[index] - ((size_t) stoul(key));
+	DataStore::Abstract::Column::Slot DataStore::Column<uint32_t>::slot() const noexcept {
+		return Unsigned;
 	}
 
-	bool DataStore::Column<uint32_t>::less(std::shared_ptr<File>, const size_t *lrow, const size_t *rrow) const {
+	size_t DataStore::Column<uint32_t>::convert(const char *text) const {
+		return (size_t) stoul(text);
+	}
+
+	bool DataStore::Column<uint32_t>::less(const std::shared_ptr<File> &, const Row &lrow, const Row &rrow) const {
 		return lrow[index] < rrow[index];
 	}
 
-	std::string DataStore::Column<uint32_t>::to_string(std::shared_ptr<File>, const size_t *row) const {
+	std::string DataStore::Column<uint32_t>::to_string(const std::shared_ptr<File> &, const Row &row) const {
 		return std::to_string((uint32_t) row[index]);
 	}
 
-	void DataStore::Column<uint32_t>::get(std::shared_ptr<File>, const size_t *row, Udjat::Value &value) const {
+	void DataStore::Column<uint32_t>::get(const std::shared_ptr<File> &, const Row &row, Udjat::Value &value) const {
 		value[name()] = (uint32_t) row[index];
 	}
 
 	// Boolean
 
-	std::string DataStore::Column<bool>::to_string(std::shared_ptr<File>, const size_t *row) const {
+	std::string DataStore::Column<bool>::to_string(const std::shared_ptr<File> &, const Row &row) const {
 		String s;
 		s.append((bool) (row[index] == 2));
 		return s;
 	}
 
 	size_t DataStore::Column<bool>::save(Deduplicator &, const char *text) const {
+		return convert(text);
+	}
+
+	size_t DataStore::Column<bool>::convert(const char *text) const {
 		return (size_t) (String{text}.as_bool() ? 2 : 1);
 	}
 
-	void DataStore::Column<bool>::get(std::shared_ptr<File>, const size_t *row, Udjat::Value &value) const {
+	void DataStore::Column<bool>::get(const std::shared_ptr<File> &, const Row &row, Udjat::Value &value) const {
 		value[name()] = (bool) (row[index] == 2);
 	}
 
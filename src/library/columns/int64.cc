@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements 64 bits integer column.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <string>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Are the values stored on the row slots?
+	static constexpr bool inline_values = (sizeof(int64_t) <= sizeof(size_t));
+
+	int64_t DataStore::Column<int64_t>::parse(const char *text) const {
+		return (int64_t) stoll(text);
+	}
+
+	int64_t DataStore::Column<int64_t>::value(const std::shared_ptr<File> &file, const Row &row) const {
+
+		if(inline_values) {
+			return (int64_t) row[index];
+		}
+
+		int64_t value = 0;
+		if(row[index]) {
+			file->read(row[index],&value,sizeof(value));
+		}
+		return value;
+
+	}
+
+	size_t DataStore::Column<int64_t>::save(Deduplicator &store, const char *text) const {
+
+		if(inline_values) {
+			return convert(text);
+		}
+
+		int64_t value{parse(text)};
+		return store.insert(&value,sizeof(value));
+
+	}
+
+	DataStore::Abstract::Column::Slot DataStore::Column<int64_t>::slot() const noexcept {
+		return inline_values ? Signed : Offset;
+	}
+
+	size_t DataStore::Column<int64_t>::convert(const char *text) const {
+
+		if(!inline_values) {
+			return Abstract::Column::convert(text);
+		}
+
+		return (size_t) parse(text);
+	}
+
+	DataStore::Abstract::Column::Key DataStore::Column<int64_t>::parse_key(const char *text) const {
+		Key key;
+		key.text = text;
+		key.value = (uint64_t) parse(text);
+		return key;
+	}
+
+	int DataStore::Column<int64_t>::comp(const std::shared_ptr<File> &file, const Row &row, const Key &key) const {
+		return compare(value(file,row),(int64_t) key.value);
+	}
+
+	bool DataStore::Column<int64_t>::less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const {
+		return value(file,lrow) < value(file,rrow);
+	}
+
+	std::string DataStore::Column<int64_t>::to_string(const std::shared_ptr<File> &file, const Row &row) const {
+		return std::to_string(value(file,row));
+	}
+
+	void DataStore::Column<int64_t>::get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const {
+		Abstract::Column::get(file,row,value,Udjat::Value::Signed);
+	}
+
+ }
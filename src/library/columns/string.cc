@@ -0,0 +1,207 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements string column.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/logger.h>
+ #include <private/structs.h>
+ #include <private/compressor.h>
+ #include <stdexcept>
+ #include <string>
+ #include <algorithm>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	DataStore::Column<std::string>::Column(const XML::Node &node, size_t index)
+		: Abstract::Column{node,index} {
+
+		const char *dictionary = node.attribute("dictionary").as_string("false");
+		if(!strcasecmp(dictionary,"sorted")) {
+			encoding = Sorted;
+		} else if(node.attribute("dictionary").as_bool(false)) {
+			encoding = Sequential;
+		}
+
+		compression = node.attribute("compress").as_bool(false);
+		if(compression && key()) {
+			throw runtime_error(Logger::String{"Primary key column '",name(),"' cant be compressed"});
+		}
+		if(compression && encoding != Plain) {
+			throw runtime_error(Logger::String{"Dictionary encoded column '",name(),"' cant be compressed"});
+		}
+
+	}
+
+	/// @brief Get dictionary for column.
+	/// @return Pointer to the code count followed by the string offsets, nullptr if the column is not encoded on file.
+	static const size_t * get_dictionary(const DataStore::File &file, size_t index) {
+
+		const DataStore::Header &header{file.get<DataStore::Header>(0)};
+		if(!header.dictionaries) {
+			return nullptr;
+		}
+
+		size_t offset = file.get_ptr<size_t>(header.dictionaries)[index];
+		if(!offset) {
+			return nullptr;
+		}
+
+		return file.get_ptr<size_t>(offset);
+
+	}
+
+	/// @brief Get symbol table for column.
+	/// @return Pointer to the symbol table, nullptr if the column is not compressed on file.
+	static const DataStore::SymbolTable * get_symbols(const DataStore::File &file, size_t index) {
+
+		const DataStore::Header &header{file.get<DataStore::Header>(0)};
+		if(!header.symbols) {
+			return nullptr;
+		}
+
+		size_t offset = file.get_ptr<size_t>(header.symbols)[index];
+		if(!offset) {
+			return nullptr;
+		}
+
+		return file.get_ptr<DataStore::SymbolTable>(offset);
+
+	}
+
+	std::string DataStore::Column<std::string>::text(const std::shared_ptr<File> &file, size_t offset) const {
+
+		if(!offset) {
+			return "";
+		}
+
+		if(compression) {
+			const SymbolTable *table = get_symbols(*file,index);
+			if(table) {
+				return Compressor::decode(*table,file->get_ptr<char>(offset));
+			}
+		}
+
+		return file->get_ptr<char>(offset);
+
+	}
+
+	size_t DataStore::Column<std::string>::heap(const std::shared_ptr<File> &file, size_t value) const {
+
+		// Unmapped files are still loading, the slots have the string offsets.
+		if(!(encoding != Plain && value && file->mapped())) {
+			return value;
+		}
+
+		const size_t *dictionary = get_dictionary(*file,index);
+		if(!dictionary) {
+			return value;
+		}
+
+		if(value > dictionary[0]) {
+			throw runtime_error(Logger::String{"Invalid dictionary code on column '",name(),"'"});
+		}
+
+		return dictionary[value];
+
+	}
+
+	bool DataStore::Column<std::string>::less(const std::shared_ptr<File> &file, const Row &lrow, const Row &rrow) const {
+
+		if(!((encoding != Plain || compression) && file->mapped())) {
+			return Abstract::Column::less(file,lrow,rrow);
+		}
+
+		if(encoding == Sorted && get_dictionary(*file,index)) {
+			return lrow[index] < rrow[index];
+		}
+
+		size_t loffset = heap(file,lrow[index]);
+		size_t roffset = heap(file,rrow[index]);
+
+		if(loffset == roffset) {
+			return false;
+		}
+
+		return less(text(file,loffset).c_str(),text(file,roffset).c_str());
+
+	}
+
+	std::string DataStore::Column<std::string>::to_string(const std::shared_ptr<File> &file, size_t value) const {
+		return text(file,heap(file,value));
+	}
+
+	std::string DataStore::Column<std::string>::to_string(const std::shared_ptr<File> &file, const Row &row) const {
+		std::string str{text(file,heap(file,row[index]))};
+		return apply_layout(str);
+	}
+
+	std::vector<bool> DataStore::Column<std::string>::select(const std::shared_ptr<File> &file, const std::function<bool(const char *value)> &test) const {
+
+		const size_t *dictionary = get_dictionary(*file,index);
+		if(!(encoding != Plain && dictionary)) {
+			throw logic_error(Logger::String{"Column '",name(),"' is not dictionary encoded"});
+		}
+
+		std::vector<bool> selected(dictionary[0]+1,false);
+		for(size_t code = 1; code <= dictionary[0]; code++) {
+			selected[code] = test(file->get_ptr<char>(dictionary[code]));
+		}
+
+		return selected;
+
+	}
+
+	std::pair<size_t,size_t> DataStore::Column<std::string>::codes(const std::shared_ptr<File> &file, const char *key, bool prefix) const {
+
+		const size_t *dictionary = get_dictionary(*file,index);
+		if(!(encoding == Sorted && dictionary)) {
+			throw logic_error(Logger::String{"Column '",name(),"' has no sorted dictionary"});
+		}
+
+		size_t length = strlen(key);
+		const size_t *first = dictionary+1;
+		const size_t *last = first+dictionary[0];
+
+		auto comp = [&file,length,prefix](size_t offset, const char *key) {
+			const char *value = file->get_ptr<char>(offset);
+			return prefix ? strncasecmp(value,key,length) : strcasecmp(value,key);
+		};
+
+		auto from = std::lower_bound(first,last,key,[&comp](size_t offset, const char *key){
+			return comp(offset,key) < 0;
+		});
+
+		auto to = std::upper_bound(from,last,key,[&comp](const char *key, size_t offset){
+			return comp(offset,key) > 0;
+		});
+
+		// Codes starts at 1.
+		return std::make_pair((size_t) (from-first)+1,(size_t) (to-first)+1);
+
+	}
+
+ }
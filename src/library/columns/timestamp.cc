@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements timestamp column.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/columns/timestamp.h>
+ #include <udjat/tools/logger.h>
+ #include <stdexcept>
+ #include <cstring>
+ #include <ctime>
+ #include <string>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	int64_t DataStore::Column<TimeStamp>::parse(const char *text) const {
+
+		while(*text && isspace(*text)) {
+			text++;
+		}
+
+		if(!*text) {
+			return 0;
+		}
+
+		// Seconds since epoch.
+		{
+			const char *ptr = text;
+			if(*ptr == '-') {
+				ptr++;
+			}
+			ptr += strspn(ptr,"0123456789");
+			if(ptr > text && !*ptr) {
+				return (int64_t) stoll(text);
+			}
+		}
+
+		// ISO-8601, 'YYYY-MM-DD[(T| )hh:mm[:ss[.fff]]][Z|(+|-)hh[:]mm]'
+		struct tm tm;
+		memset(&tm,0,sizeof(tm));
+
+		int length = 0;
+		if(sscanf(text,"%4d-%2d-%2d%n",&tm.tm_year,&tm.tm_mon,&tm.tm_mday,&length) != 3) {
+			throw runtime_error(Logger::String{"Invalid timestamp '",text,"'"});
+		}
+
+		const char *ptr = text+length;
+		if(*ptr == 'T' || *ptr == 't' || *ptr == ' ') {
+
+			length = 0;
+			if(sscanf(ptr+1,"%2d:%2d%n",&tm.tm_hour,&tm.tm_min,&length) != 2) {
+				throw runtime_error(Logger::String{"Invalid time on timestamp '",text,"'"});
+			}
+			ptr += length+1;
+
+			if(*ptr == ':') {
+				length = 0;
+				if(sscanf(ptr+1,"%2d%n",&tm.tm_sec,&length) != 1) {
+					throw runtime_error(Logger::String{"Invalid seconds on timestamp '",text,"'"});
+				}
+				ptr += length+1;
+			}
+
+			// Ignore fractions of second.
+			if(*ptr == '.' || *ptr == ',') {
+				ptr++;
+				ptr += strspn(ptr,"0123456789");
+			}
+
+		}
+
+		tm.tm_year -= 1900;
+		tm.tm_mon--;
+
+#ifdef _WIN32
+		int64_t value = (int64_t) _mkgmtime(&tm);
+#else
+		int64_t value = (int64_t) timegm(&tm);
+#endif // _WIN32
+
+		// Timezone, the default is UTC.
+		if(*ptr == 'Z' || *ptr == 'z') {
+			ptr++;
+		} else if(*ptr == '+' || *ptr == '-') {
+
+			int hours = 0, minutes = 0;
+			length = 0;
+			if(sscanf(ptr+1,"%2d%n",&hours,&length) != 1) {
+				throw runtime_error(Logger::String{"Invalid timezone on timestamp '",text,"'"});
+			}
+
+			const char *tz = ptr+1+length;
+			if(*tz == ':') {
+				tz++;
+			}
+			length = 0;
+			if(isdigit(*tz) && sscanf(tz,"%2d%n",&minutes,&length) == 1) {
+				tz += length;
+			}
+
+			// Local time is UTC plus offset.
+			int64_t offset = (hours * 3600) + (minutes * 60);
+			value += (*ptr == '+' ? -offset : offset);
+			ptr = tz;
+
+		}
+
+		while(*ptr && isspace(*ptr)) {
+			ptr++;
+		}
+
+		if(*ptr) {
+			throw runtime_error(Logger::String{"Unexpected '",ptr,"' on timestamp '",text,"'"});
+		}
+
+		return value;
+
+	}
+
+	std::string DataStore::Column<TimeStamp>::to_string(const std::shared_ptr<File> &file, const Row &row) const {
+
+		time_t value = (time_t) this->value(file,row);
+		if(!value) {
+			return "";
+		}
+
+		struct tm tm;
+#ifdef _WIN32
+		gmtime_s(&tm,&value);
+#else
+		gmtime_r(&value,&tm);
+#endif // _WIN32
+
+		char buffer[32];
+		strftime(buffer,sizeof(buffer),"%Y-%m-%dT%H:%M:%SZ",&tm);
+		return buffer;
+
+	}
+
+	void DataStore::Column<TimeStamp>::get(const std::shared_ptr<File> &file, const Row &row, Udjat::Value &value) const {
+		value[name()] = TimeStamp{(time_t) this->value(file,row)};
+	}
+
+ }
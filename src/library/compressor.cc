@@ -0,0 +1,177 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements string compressor.
+  *
+  * The symbol table is built in a few generations, on each one the sample is
+  * compressed with the current table and the symbols (and concatenations of
+  * adjacent symbols) with the best gain are selected for the next one.
+  *
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/compressor.h>
+ #include <cstring>
+ #include <algorithm>
+ #include <map>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	DataStore::Compressor::Compressor(const std::vector<std::string> &sample) {
+
+		memset(&table,0,sizeof(table));
+
+		for(size_t generation = 0; generation < 5; generation++) {
+
+			// Count symbols and symbol concatenations.
+			std::map<std::string,size_t> counts;
+
+			for(const std::string &text : sample) {
+
+				const char *ptr = text.c_str();
+				std::string previous;
+
+				while(*ptr) {
+
+					uint8_t code = find(ptr);
+					std::string current{ptr,code ? (size_t) table.length[code] : 1};
+
+					counts[current]++;
+
+					if(!previous.empty()) {
+						std::string concat{previous+current};
+						if(concat.size() > sizeof(table.symbol[0])) {
+							concat.resize(sizeof(table.symbol[0]));
+						}
+						counts[concat]++;
+					}
+
+					previous = current;
+					ptr += current.size();
+
+				}
+
+			}
+
+			// Select the symbols with the best gain.
+			std::vector<std::pair<size_t,std::string>> gains;
+			gains.reserve(counts.size());
+			for(const auto &count : counts) {
+				gains.emplace_back(count.second * count.first.size(),count.first);
+			}
+
+			std::sort(gains.begin(),gains.end(),[](const std::pair<size_t,std::string> &l, const std::pair<size_t,std::string> &r){
+				return l.first == r.first ? l.second < r.second : l.first > r.first;
+			});
+
+			memset(&table,0,sizeof(table));
+
+			uint8_t code = 1;
+			for(const auto &gain : gains) {
+				if(code == Escape) {
+					break;
+				}
+				table.length[code] = (uint8_t) gain.second.size();
+				memcpy(table.symbol[code],gain.second.c_str(),gain.second.size());
+				code++;
+			}
+
+			rebuild();
+
+		}
+
+	}
+
+	void DataStore::Compressor::rebuild() {
+
+		for(auto &list : candidates) {
+			list.clear();
+		}
+
+		for(size_t code = 1; code < Escape; code++) {
+			if(table.length[code]) {
+				candidates[(uint8_t) table.symbol[code][0]].push_back((uint8_t) code);
+			}
+		}
+
+		for(auto &list : candidates) {
+			std::stable_sort(list.begin(),list.end(),[this](uint8_t l, uint8_t r){
+				return table.length[l] > table.length[r];
+			});
+		}
+
+	}
+
+	uint8_t DataStore::Compressor::find(const char *text) const noexcept {
+
+		for(uint8_t code : candidates[(uint8_t) *text]) {
+			if(!strncmp(text,table.symbol[code],table.length[code])) {
+				return code;
+			}
+		}
+
+		return 0;
+	}
+
+	std::string DataStore::Compressor::encode(const char *text) const {
+
+		std::string rc;
+		rc.reserve(strlen(text));
+
+		while(*text) {
+
+			uint8_t code = find(text);
+			if(code) {
+				rc += (char) code;
+				text += table.length[code];
+			} else {
+				rc += (char) Escape;
+				rc += *(text++);
+			}
+
+		}
+
+		return rc;
+	}
+
+	std::string DataStore::Compressor::decode(const SymbolTable &table, const char *data) {
+
+		std::string rc;
+		const uint8_t *ptr = (const uint8_t *) data;
+
+		while(*ptr) {
+
+			if(*ptr == Escape) {
+				rc += (char) ptr[1];
+				ptr += 2;
+			} else {
+				rc.append(table.symbol[*ptr],table.length[*ptr]);
+				ptr++;
+			}
+
+		}
+
+		return rc;
+	}
+
+ }
@@ -29,11 +29,15 @@
  #include <udjat/tools/datastore/loader.h>
  #include <udjat/tools/datastore/file.h>
  #include <udjat/tools/datastore/columns/ipv4.h>
+ #include <udjat/tools/datastore/columns/timestamp.h>
  #include <udjat/tools/object.h>
  #include <udjat/tools/timestamp.h>
  #include <udjat/tools/singleton.h>
  #include <private/structs.h>
+ #include <private/iterator.h>
+ #include <udjat/tools/string.h>
  #include <udjat/tools/quark.h>
+ #include <algorithm>
 
  using namespace std;
 
@@ -52,6 +56,7 @@
 		: name{Quark{definition,"name"}.c_str()},
 			path{Object::getAttribute(definition,"sources-from","")},
 			expires{XML::AttributeFactory(definition,"max-age").as_uint(3600)},
+			shared_path{Object::getAttribute(definition,"shared-store","")},
 			filespec{Object::getAttribute(definition,"sources-file-filter",".*")} {
 
 		if(!*name) {
@@ -62,6 +67,36 @@
 			throw runtime_error("Required attribute 'path' is missing");
 		}
 
+		{
+			const char *layout = XML::AttributeFactory(definition,"layout").as_string("row");
+			if(!strcasecmp(layout,"columnar")) {
+				columnar_layout = true;
+			} else if(strcasecmp(layout,"row")) {
+				throw runtime_error(Logger::String{"Unexpected layout '",layout,"'"});
+			}
+		}
+
+		{
+			const char *access = XML::AttributeFactory(definition,"madvise").as_string("normal");
+			if(!strcasecmp(access,"random")) {
+				memory.access = File::Random;
+			} else if(!strcasecmp(access,"sequential")) {
+				memory.access = File::Sequential;
+			} else if(strcasecmp(access,"normal")) {
+				throw runtime_error(Logger::String{"Unexpected madvise profile '",access,"'"});
+			}
+		}
+
+		memory.lock = XML::AttributeFactory(definition,"mlock").as_bool(false);
+		memory.huge_pages = XML::AttributeFactory(definition,"huge-pages").as_bool(false);
+
+		latency.tlb_counters(XML::AttributeFactory(definition,"tlb-counters").as_bool(false));
+
+		history.length = XML::AttributeFactory(definition,"load-history").as_uint(history.length);
+
+		warmup.enabled = XML::AttributeFactory(definition,"warm-up").as_bool(true);
+		warmup.queries = XML::AttributeFactory(definition,"warm-up-queries").as_uint(0);
+
 		size_t index = 0;
 		for(XML::Node child = definition.child("column"); child; child = child.next_sibling("column")) {
 
@@ -75,6 +110,15 @@
 			} else if(!strcasecmp(type,"uint")) {
 				col = make_shared<Column<unsigned int>>(child,index++);
 
+			} else if(!strcasecmp(type,"int64") || !strcasecmp(type,"long")) {
+				col = make_shared<Column<int64_t>>(child,index++);
+
+			} else if(!strcasecmp(type,"double") || !strcasecmp(type,"real")) {
+				col = make_shared<Column<double>>(child,index++);
+
+			} else if(!strcasecmp(type,"timestamp")) {
+				col = make_shared<Column<TimeStamp>>(child,index++);
+
 			} else if(!strcasecmp(type,"string")) {
 				col = make_shared<Column<std::string>>(child,index++);
 
@@ -99,6 +143,33 @@
 
 		}
 
+		for(XML::Node child = definition.child("index"); child; child = child.next_sibling("index")) {
+
+			String names{child,"columns",""};
+
+			Composite composite;
+			composite.name = String{child,"name",names.c_str()}.as_quark();
+
+			for(auto colname : names.split(",")) {
+				colname.strip();
+				if(colname.empty()) {
+					continue;
+				}
+				size_t ix = column_index(colname.c_str());
+				if(ix == ((size_t) -1)) {
+					throw runtime_error(Logger::String{"Unexpected column '",colname.c_str(),"' on index '",composite.name,"'"});
+				}
+				composite.columns.push_back((uint16_t) ix);
+			}
+
+			if(composite.columns.empty()) {
+				throw runtime_error("Required attribute 'columns' is missing or empty");
+			}
+
+			composites.push_back(composite);
+
+		}
+
 		containers.getInstance().push_back(this);
 	}
 
@@ -107,7 +178,7 @@
 	}
 
 	bool DataStore::Container::push_back(const XML::Node &node) {
-		queries.push_back(Query::Factory(node,cols));
+		queries.push_back(Query::Factory(node,cols,(uint16_t) queries.size()));
 		return true;
 	}
 
@@ -129,7 +200,8 @@
 	}
 
 	size_t DataStore::Container::size() const {
-		return active_file->get<size_t>(active_file->get<Header>(0).primary_offset);
+		auto file{snapshot()};
+		return file->get<size_t>(file->get<Header>(0).primary_offset);
 	}
 
 	//TimeStamp DataStore::Container::update_time() const {
@@ -137,20 +209,89 @@
 	//}
 
 	void DataStore::Container::load() {
-		auto file = Loader::CSV{*this,path,filespec}.load();
-		file->map(); // Map file in memory.
-		active_file = file;
+
+		std::shared_ptr<File> file;
+
+		if(*shared_path) {
+
+			file = shared();
+			if(!file) {
+				Logger::String{"Shared storage '",shared_path,"' is up to date"}.trace(name);
+				state(size() ? Ready : Empty);
+				return;
+			}
+
+		} else {
+
+			file = Loader::CSV{*this,path,filespec}.load();
+
+		}
+
+		if(!file->mapped()) {
+			file->map(); // Map file in memory.
+		}
+
+		// Apply memory policy.
+		{
+			size_t length = file->size();
+			size_t indexes = file->get<Header>(0).primary_offset;
+
+			if(memory.access != File::Normal) {
+				file->advise(0,length,memory.access);
+			}
+
+			if(memory.huge_pages && indexes < length) {
+				file->huge_pages(indexes,length-indexes);
+			}
+
+			if(memory.lock) {
+				file->lock();
+			}
+		}
+
+		if(warmup.enabled) {
+			prefetch(file);
+		}
+		active_file.set(file);
+
+		{
+			std::lock_guard<std::mutex> lock{generations.guard};
+			generations.files.erase(
+				std::remove_if(generations.files.begin(),generations.files.end(),[](const std::weak_ptr<File> &file){
+					return file.expired();
+				}),
+				generations.files.end()
+			);
+			generations.files.push_back(file);
+		}
+
 		Logger::String{"New storage with ",size()," record(s) is active (",TimeStamp{last_modified()}.to_string(),")"}.trace(name);
 		state(size() ? Ready : Empty);
 	}
 
+	void DataStore::Container::statistics(const LoadStatistics &stats) {
+
+		std::lock_guard<std::mutex> lock{history.guard};
+
+		history.builds.push_front(stats);
+		while(history.builds.size() > history.length) {
+			history.builds.pop_back();
+		}
+
+	}
+
+	std::deque<DataStore::LoadStatistics> DataStore::Container::statistics() const {
+		std::lock_guard<std::mutex> lock{history.guard};
+		return history.builds;
+	}
+
 	DataStore::Iterator DataStore::Container::find(const char *path) const {
-		return DataStore::Iterator::Factory(this->active_file, this->columns(), path);
+		return DataStore::Iterator::Factory(snapshot(), this->columns(), path);
 	}
 
 	std::shared_ptr<DataStore::Abstract::Column> DataStore::Container::column(const char *name) const {
 
-		for(auto col : cols) {
+		for(const auto &col : cols) {
 			if(!strcasecmp(name,col->name())) {
 				return col;
 			}
@@ -168,32 +309,183 @@
 
 	time_t DataStore::Container::last_modified() const {
 
-		if(!active_file) {
+		auto file{snapshot()};
+		if(!file) {
 			throw runtime_error("Container is empty");
 		}
 
-		return active_file->get<Header>(0).last_modified;
+		return file->get<Header>(0).last_modified;
 	}
 
 	DataStore::Iterator DataStore::Container::find(Request &request) {
 
+		// Use the same generation for the entire request.
+		auto file{snapshot()};
+
 		// Search for query.
 		for(const auto &query : queries) {
 
 			if( *query == request && request.pop(query->path())) {
-				return query->call(cols,active_file,request);
+
+				DataStore::Iterator it{query->call(cols,file,request)};
+
+				String filter{request.getArgument("filter")};
+				if(!filter.empty()) {
+					it.filter(filter.c_str());
+				}
+
+				return it;
 			}
 
 		}
 
-		return DataStore::Iterator::Factory(active_file,cols,request);
+		if(warmup.queries) {
+			// Remember the search for the next warm-up, never wait for it.
+			std::unique_lock<std::mutex> lock{warmup.guard,std::try_to_lock};
+			if(lock.owns_lock()) {
+				warmup.recent.emplace_front(request.path());
+				if(warmup.recent.size() > warmup.queries) {
+					warmup.recent.pop_back();
+				}
+			}
+		}
+
+		return DataStore::Iterator::Factory(file,cols,request);
+
+	}
+
+	bool DataStore::Container::batch(const Request &request, Response::Table &response) const {
+
+		const char *path = request.path();
+		while(*path && *path == '/') {
+			path++;
+		}
+
+		std::shared_ptr<Iterator::Handler> handler;
+		auto file{snapshot()};
+
+		if(!strcasecmp(path,"batch")) {
+
+			// Search on primary key.
+			handler = make_shared<PrimaryKeyHandler>(file);
+
+		} else {
+
+			const char *ptr = strrchr(path,'/');
+			if(!(ptr && !strcasecmp(ptr+1,"batch"))) {
+				return false;
+			}
+
+			// Search on column index.
+			size_t ix = column_index(string{path,(size_t) (ptr-path)}.c_str());
+			if(ix == ((size_t) -1)) {
+				return false;
+			}
+
+			if(!cols[ix]->indexed()) {
+				throw runtime_error(Logger::String{"Column '",cols[ix]->name(),"' is not indexed"});
+			}
+
+			handler = make_shared<ColumnKeyHandler>(file,(uint16_t) ix);
+
+		}
+
+		// Get keys, separated by ',' or line breaks.
+		std::vector<std::string> keys;
+		{
+			String args{request.getArgument("keys")};
+			const char *ptr = args.c_str();
+			while(*ptr) {
+				size_t length = strcspn(ptr,",\r\n");
+				if(length) {
+					String key{string{ptr,length}};
+					key.strip();
+					if(!key.empty()) {
+						keys.push_back(key);
+					}
+				}
+				ptr += length;
+				if(*ptr) {
+					ptr++;
+				}
+			}
+		}
+
+		return Iterator{file,cols,handler}.batch(keys,response);
+
+	}
+
+	bool DataStore::Container::aggregate(const Request &request, Response::Table &response) const {
+
+		const char *path = request.path();
+		while(*path && *path == '/') {
+			path++;
+		}
+
+		std::vector<uint16_t> columns;
+		bool counts = true;
+
+		if(!strncasecmp(path,"groupby/",8)) {
+
+			for(auto name : String{path+8}.split("/")) {
+				name.strip();
+				if(name.empty()) {
+					continue;
+				}
+				size_t ix = column_index(name.c_str());
+				if(ix == ((size_t) -1)) {
+					throw runtime_error(Logger::String{"Unexpected column '",name.c_str(),"'"});
+				}
+				columns.push_back((uint16_t) ix);
+			}
+
+			if(columns.empty()) {
+				throw runtime_error("Group by requires at least one column, use 'groupby/<column>'");
+			}
+
+		} else {
+
+			const char *ptr = strrchr(path,'/');
+			if(!ptr) {
+				return false;
+			}
+
+			if(!strcasecmp(ptr+1,"distinct")) {
+				counts = false;
+			} else if(strcasecmp(ptr+1,"count")) {
+				return false;
+			}
+
+			size_t ix = column_index(string{path,(size_t) (ptr-path)}.c_str());
+			if(ix == ((size_t) -1)) {
+				return false;
+			}
+			columns.push_back((uint16_t) ix);
+
+		}
+
+		auto file{snapshot()};
+
+		String filter{request.getArgument("filter")};
+		if(!filter.empty()) {
+			Iterator it{Iterator::Factory(file,cols,"")};
+			it.filter(filter.c_str(),true);
+			return it.aggregate(columns,counts,response);
+		}
+
+		if(columns.size() == 1 && cols[columns[0]]->indexed() && cols[columns[0]]->slot() == Abstract::Column::Offset) {
+			// Walk the column index, the rows with the same value are together.
+			return Iterator{file,cols,make_shared<ColumnKeyHandler>(file,columns[0])}.aggregate(columns,counts,response);
+		}
+
+		return Iterator{file,cols,make_shared<PrimaryKeyHandler>(file)}.aggregate(columns,counts,response);
 
 	}
 
 	size_t DataStore::Container::column_index(const char *name) const {
 
 		size_t index = 0;
-		for(auto col : cols) {
+		for(const auto &col : cols) {
 			if(!strcasecmp(name,col->name())) {
 				return index;
 			}
@@ -204,7 +496,7 @@
 		for(const Alias &alias : aliases) {
 			if(!strcasecmp(name,alias.name)) {
 				size_t index = 0;
-				for(auto col : cols) {
+				for(const auto &col : cols) {
 					if(col.get() == alias.col.get()) {
 						return index;
 					}
@@ -61,11 +61,15 @@
 
 		std::lock_guard<std::mutex> lock(guard);
 
+		lookups++;
+
 //		debug("block count is ",blocks.size());
 
 		auto block = blocks.find(record);
 		if(block != blocks.end()) {
 //			debug("Got block, using it")
+			hits++;
+			reused += length;
 			return block->offset;
 		}
 
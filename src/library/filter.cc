@@ -0,0 +1,527 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements row filter.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/filter.h>
+ #include <private/iterator.h>
+ #include <private/bitmap.h>
+ #include <private/postings.h>
+ #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <stdexcept>
+ #include <functional>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	DataStore::Filter::Node::~Node() {
+	}
+
+	bool DataStore::Filter::Node::select(Postings &) const {
+		return false;
+	}
+
+	/// @brief Get value from inline slot.
+	template <typename T>
+	static inline T slot_value(size_t slot) noexcept {
+		return (T) slot;
+	}
+
+	template <>
+	inline double slot_value<double>(size_t slot) noexcept {
+		return DataStore::Column<double>::value(slot);
+	}
+
+	/// @brief Compare inline (integer or floating point) slots.
+	template <typename T, typename Compare>
+	class SlotNode : public DataStore::Filter::Node {
+	private:
+		size_t column;
+		T key;
+
+	public:
+		SlotNode(size_t c, T k) : column{c}, key{k} {
+		}
+
+		void evaluate(const DataStore::Row *rows, size_t count, uint8_t *selected) const override {
+			Compare compare;
+			for(size_t ix = 0; ix < count; ix++) {
+				selected[ix] = compare(slot_value<T>(rows[ix][column]),key) ? 1 : 0;
+			}
+		}
+
+	};
+
+	template <typename T>
+	static std::shared_ptr<DataStore::Filter::Node> SlotNodeFactory(size_t column, DataStore::Filter::Operator op, T key) {
+
+		switch(op) {
+		case DataStore::Filter::Equal:
+			return make_shared<SlotNode<T,std::equal_to<T>>>(column,key);
+
+		case DataStore::Filter::NotEqual:
+			return make_shared<SlotNode<T,std::not_equal_to<T>>>(column,key);
+
+		case DataStore::Filter::Less:
+			return make_shared<SlotNode<T,std::less<T>>>(column,key);
+
+		case DataStore::Filter::LessOrEqual:
+			return make_shared<SlotNode<T,std::less_equal<T>>>(column,key);
+
+		case DataStore::Filter::Greater:
+			return make_shared<SlotNode<T,std::greater<T>>>(column,key);
+
+		case DataStore::Filter::GreaterOrEqual:
+			return make_shared<SlotNode<T,std::greater_equal<T>>>(column,key);
+
+		default:
+			throw logic_error("Unexpected operator for inline value comparison");
+		}
+
+	}
+
+	/// @brief Test dictionary codes, the values were tested once on the dictionary.
+	class CodeNode : public DataStore::Filter::Node {
+	private:
+		size_t column;
+		std::vector<bool> codes;
+
+	public:
+		CodeNode(size_t c, std::vector<bool> &&s) : column{c}, codes{s} {
+		}
+
+		void evaluate(const DataStore::Row *rows, size_t count, uint8_t *selected) const override {
+			for(size_t ix = 0; ix < count; ix++) {
+				size_t code = rows[ix][column];
+				selected[ix] = (code < codes.size() && codes[code]) ? 1 : 0;
+			}
+		}
+
+	};
+
+	/// @brief Test the column text.
+	class TextNode : public DataStore::Filter::Node {
+	private:
+		std::shared_ptr<DataStore::File> file;
+		std::shared_ptr<DataStore::Abstract::Column> column;
+		std::function<bool(const char *)> test;
+
+	public:
+		TextNode(std::shared_ptr<DataStore::File> f, std::shared_ptr<DataStore::Abstract::Column> c, const std::function<bool(const char *)> &t)
+			: file{f}, column{c}, test{t} {
+		}
+
+		void evaluate(const DataStore::Row *rows, size_t count, uint8_t *selected) const override {
+			for(size_t ix = 0; ix < count; ix++) {
+				selected[ix] = test(column->to_string(file,rows[ix]).c_str()) ? 1 : 0;
+			}
+		}
+
+	};
+
+	class AndNode : public DataStore::Filter::Node {
+	private:
+		std::shared_ptr<DataStore::Filter::Node> left, right;
+
+	public:
+		AndNode(std::shared_ptr<DataStore::Filter::Node> l, std::shared_ptr<DataStore::Filter::Node> r) : left{l}, right{r} {
+		}
+
+		void evaluate(const DataStore::Row *rows, size_t count, uint8_t *selected) const override {
+			uint8_t other[DataStore::Filter::batch];
+			left->evaluate(rows,count,selected);
+			right->evaluate(rows,count,other);
+			for(size_t ix = 0; ix < count; ix++) {
+				selected[ix] &= other[ix];
+			}
+		}
+
+		bool select(DataStore::Postings &records) const override {
+
+			// Any side is enough, intersect if both can use an index.
+			if(!left->select(records)) {
+				return right->select(records);
+			}
+
+			if(!records.empty()) {
+				DataStore::Postings other;
+				if(right->select(other)) {
+					records &= other;
+				}
+			}
+
+			return true;
+		}
+
+	};
+
+	class OrNode : public DataStore::Filter::Node {
+	private:
+		std::shared_ptr<DataStore::Filter::Node> left, right;
+
+	public:
+		OrNode(std::shared_ptr<DataStore::Filter::Node> l, std::shared_ptr<DataStore::Filter::Node> r) : left{l}, right{r} {
+		}
+
+		void evaluate(const DataStore::Row *rows, size_t count, uint8_t *selected) const override {
+			uint8_t other[DataStore::Filter::batch];
+			left->evaluate(rows,count,selected);
+			right->evaluate(rows,count,other);
+			for(size_t ix = 0; ix < count; ix++) {
+				selected[ix] |= other[ix];
+			}
+		}
+
+		bool select(DataStore::Postings &records) const override {
+
+			// Both sides are required.
+			DataStore::Postings other;
+			if(!(left->select(records) && right->select(other))) {
+				return false;
+			}
+
+			records |= other;
+			return true;
+		}
+
+	};
+
+	class NotNode : public DataStore::Filter::Node {
+	private:
+		std::shared_ptr<DataStore::Filter::Node> node;
+
+	public:
+		NotNode(std::shared_ptr<DataStore::Filter::Node> n) : node{n} {
+		}
+
+		void evaluate(const DataStore::Row *rows, size_t count, uint8_t *selected) const override {
+			node->evaluate(rows,count,selected);
+			for(size_t ix = 0; ix < count; ix++) {
+				selected[ix] ^= 1;
+			}
+		}
+
+	};
+
+	/// @brief Predicate on indexed column, the records can be selected from the column index or bitmap.
+	class IndexNode : public DataStore::Filter::Node {
+	private:
+		std::shared_ptr<DataStore::Filter::Node> node;
+		std::shared_ptr<DataStore::File> file;
+		std::vector<std::shared_ptr<DataStore::Abstract::Column>> cols;
+		uint16_t column;
+		DataStore::Filter::Operator op;
+		std::string value;
+
+	public:
+		IndexNode(std::shared_ptr<DataStore::Filter::Node> n, std::shared_ptr<DataStore::File> f, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &c, uint16_t cl, DataStore::Filter::Operator o, const std::string &v)
+			: node{n}, file{f}, cols{c}, column{cl}, op{o}, value{v} {
+		}
+
+		void evaluate(const DataStore::Row *rows, size_t count, uint8_t *selected) const override {
+			node->evaluate(rows,count,selected);
+		}
+
+		bool select(DataStore::Postings &records) const override {
+
+			const auto &col{cols[column]};
+
+			if(col->bitmap() && op == DataStore::Filter::Equal) {
+				records = DataStore::Postings{*file,DataStore::Bitmap::Factory(file,cols,(std::string{col->name()} + "/" + value).c_str())};
+				return true;
+			}
+
+			if(!col->indexed()) {
+				return false;
+			}
+
+			// Inclusive ranges, the filter will test the limits.
+			const char *from = nullptr;
+			const char *to = nullptr;
+
+			switch(op) {
+			case DataStore::Filter::Equal:
+				from = to = value.c_str();
+				break;
+
+			case DataStore::Filter::Less:
+			case DataStore::Filter::LessOrEqual:
+				to = value.c_str();
+				break;
+
+			case DataStore::Filter::Greater:
+			case DataStore::Filter::GreaterOrEqual:
+				from = value.c_str();
+				break;
+
+			default:
+				return false;
+			}
+
+			DataStore::RangeKeyHandler range{DataStore::Iterator{file,cols},column,from,to};
+			records = DataStore::Postings{range.entries(),range.size()};
+
+			debug("Index on '",col->name(),"' has selected ",records.size()," record(s)");
+			return true;
+
+		}
+
+	};
+
+	/// @brief Compare strings (case insensitive).
+	static bool test(DataStore::Filter::Operator op, const char *value, const char *key) {
+
+		if(op == DataStore::Filter::Contains) {
+			return String::strcasestr(value,key) != nullptr;
+		}
+
+		int rc = strcasecmp(value,key);
+
+		switch(op) {
+		case DataStore::Filter::Equal:
+			return rc == 0;
+
+		case DataStore::Filter::NotEqual:
+			return rc != 0;
+
+		case DataStore::Filter::Less:
+			return rc < 0;
+
+		case DataStore::Filter::LessOrEqual:
+			return rc <= 0;
+
+		case DataStore::Filter::Greater:
+			return rc > 0;
+
+		case DataStore::Filter::GreaterOrEqual:
+			return rc >= 0;
+
+		default:
+			throw logic_error("Unexpected operator for string comparison");
+		}
+
+	}
+
+	static inline const char * skip_spaces(const char *ptr) {
+		while(*ptr && isspace(*ptr)) {
+			ptr++;
+		}
+		return ptr;
+	}
+
+	DataStore::Filter::Filter(std::shared_ptr<File> f, const std::vector<std::shared_ptr<Abstract::Column>> &c, const char *expression)
+		: file{f}, cols{c} {
+
+		const char *ptr = expression;
+		root = parse_or(ptr);
+
+		ptr = skip_spaces(ptr);
+		if(*ptr) {
+			throw runtime_error(Logger::String{"Unexpected '",ptr,"' on filter expression"});
+		}
+
+	}
+
+	std::shared_ptr<DataStore::Filter::Node> DataStore::Filter::parse_or(const char * &ptr) {
+
+		std::shared_ptr<Node> node{parse_and(ptr)};
+
+		ptr = skip_spaces(ptr);
+		while(*ptr == '|') {
+			ptr++;
+			node = make_shared<OrNode>(node,parse_and(ptr));
+			ptr = skip_spaces(ptr);
+		}
+
+		return node;
+	}
+
+	std::shared_ptr<DataStore::Filter::Node> DataStore::Filter::parse_and(const char * &ptr) {
+
+		std::shared_ptr<Node> node{parse_unary(ptr)};
+
+		ptr = skip_spaces(ptr);
+		while(*ptr == '&' || *ptr == ',') {
+			ptr++;
+			node = make_shared<AndNode>(node,parse_unary(ptr));
+			ptr = skip_spaces(ptr);
+		}
+
+		return node;
+	}
+
+	std::shared_ptr<DataStore::Filter::Node> DataStore::Filter::parse_unary(const char * &ptr) {
+
+		ptr = skip_spaces(ptr);
+
+		if(*ptr == '!') {
+			ptr++;
+			return make_shared<NotNode>(parse_unary(ptr));
+		}
+
+		if(*ptr == '(') {
+			ptr++;
+			std::shared_ptr<Node> node{parse_or(ptr)};
+			ptr = skip_spaces(ptr);
+			if(*ptr != ')') {
+				throw runtime_error("Unbalanced parentheses on filter expression");
+			}
+			ptr++;
+			return node;
+		}
+
+		// Get column name.
+		const char *from = ptr;
+		while(*ptr && !strchr("=!<>~&|,()",*ptr)) {
+			ptr++;
+		}
+
+		String name{string{from,(size_t) (ptr-from)}};
+		name.strip();
+
+		if(name.empty()) {
+			throw runtime_error("Expecting column name on filter expression");
+		}
+
+		// Get operator.
+		Operator op;
+		if(!strncmp(ptr,"!=",2)) {
+			op = NotEqual;
+			ptr += 2;
+		} else if(!strncmp(ptr,"<=",2)) {
+			op = LessOrEqual;
+			ptr += 2;
+		} else if(!strncmp(ptr,">=",2)) {
+			op = GreaterOrEqual;
+			ptr += 2;
+		} else if(!strncmp(ptr,"==",2)) {
+			op = Equal;
+			ptr += 2;
+		} else if(*ptr == '=') {
+			op = Equal;
+			ptr++;
+		} else if(*ptr == '<') {
+			op = Less;
+			ptr++;
+		} else if(*ptr == '>') {
+			op = Greater;
+			ptr++;
+		} else if(*ptr == '~') {
+			op = Contains;
+			ptr++;
+		} else {
+			throw runtime_error(Logger::String{"Expecting operator after '",name.c_str(),"' on filter expression"});
+		}
+
+		// Get value.
+		from = ptr;
+		while(*ptr && !strchr("&|,)",*ptr)) {
+			ptr++;
+		}
+
+		String value{string{from,(size_t) (ptr-from)}};
+		value.strip();
+
+		// Get column.
+		for(size_t column = 0; column < cols.size(); column++) {
+			if(!strcasecmp(cols[column]->name(),name.c_str())) {
+				std::shared_ptr<Node> node{predicate((uint16_t) column,op,value)};
+				if(cols[column]->indexed() || cols[column]->bitmap()) {
+					node = make_shared<IndexNode>(node,file,cols,(uint16_t) column,op,value);
+				}
+				return node;
+			}
+		}
+
+		throw runtime_error(Logger::String{"Unexpected column '",name.c_str(),"' on filter expression"});
+
+	}
+
+	std::shared_ptr<DataStore::Filter::Node> DataStore::Filter::predicate(uint16_t column, Operator op, const std::string &value) const {
+
+		const auto &col{cols[column]};
+
+		// Inline values, compare the row slots.
+		if(op != Contains) {
+
+			switch(col->slot()) {
+			case Abstract::Column::Signed:
+				return SlotNodeFactory<int64_t>(column,op,(int64_t) col->convert(value.c_str()));
+
+			case Abstract::Column::Unsigned:
+				return SlotNodeFactory<uint64_t>(column,op,(uint64_t) col->convert(value.c_str()));
+
+			case Abstract::Column::Real:
+				return SlotNodeFactory<double>(column,op,slot_value<double>(col->convert(value.c_str())));
+
+			default:
+				break;
+			}
+
+		}
+
+		// Dictionary encoded strings, test the dictionary once and compare the codes.
+		auto strcol = dynamic_cast<const Column<std::string> *>(col.get());
+		if(strcol && strcol->dictionary()) {
+
+			std::vector<bool> codes{strcol->select(file,[op,&value](const char *text){
+				return test(op,text,value.c_str());
+			})};
+
+			if(!codes.empty()) {
+				codes[0] = test(op,"",value.c_str());
+			}
+
+			return make_shared<CodeNode>(column,std::move(codes));
+
+		}
+
+		// Compare the column text.
+		std::string key{value};
+		return make_shared<TextNode>(file,col,[op,key](const char *text){
+			return test(op,text,key.c_str());
+		});
+
+	}
+
+	std::shared_ptr<DataStore::Iterator::Handler> DataStore::Filter::index() const {
+
+		Postings records;
+		if(!root->select(records)) {
+			return std::shared_ptr<Iterator::Handler>();
+		}
+
+		auto handler = make_shared<CustomKeyHandler>();
+		records.for_each(*file,[&handler](const Row &row){
+			handler->push_back(row);
+		});
+
+		return handler;
+
+	}
+
+ }
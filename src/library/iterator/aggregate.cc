@@ -0,0 +1,286 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements row aggregation.
+  */
+
+ #include <config.h>
+ #include <udjat/tools/datastore/iterator.h>
+ #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/logger.h>
+ #include <private/structs.h>
+ #include <private/iterator.h>
+ #include <unordered_map>
+ #include <algorithm>
+ #include <thread>
+ #include <atomic>
+ #include <cctype>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Minimum rows for each aggregation thread.
+	static const size_t rows_per_thread = 65536;
+
+	/// @brief Aggregation threads running for all requests.
+	static std::atomic<size_t> running{0};
+
+	namespace {
+
+		/// @brief Aggregation threads reserved from the process wide budget.
+		class Workers {
+		public:
+			size_t threads = 0;
+
+			Workers(size_t wanted) {
+				const size_t limit = std::max(std::thread::hardware_concurrency(),1U);
+				size_t active = running.load();
+				do {
+					threads = (active < limit ? std::min(wanted,limit - active) : 0);
+				} while(threads && !running.compare_exchange_weak(active,active + threads));
+			}
+
+			~Workers() {
+				running -= threads;
+			}
+
+		};
+
+		/// @brief The column slots of a group.
+		using Key = std::vector<size_t>;
+
+		struct KeyHash {
+			size_t operator()(const Key &key) const noexcept {
+				size_t hash = 0;
+				for(size_t value : key) {
+					hash ^= std::hash<size_t>{}(value) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+				}
+				return hash;
+			}
+		};
+
+		struct Group {
+			DataStore::Row row;		///< @brief The first row with the group values.
+			size_t count = 0;		///< @brief Number of rows on group.
+		};
+
+		using Groups = std::unordered_map<Key,Group,KeyHash>;
+
+	}
+
+	bool DataStore::Iterator::aggregate(const std::vector<uint16_t> &columns, bool counts, Udjat::Response::Table &value) const {
+
+		value.last_modified(file->get<Header>(0).last_modified);
+
+		// Empty strings (offset 0) are not values.
+		std::vector<bool> strings;
+		for(uint16_t column : columns) {
+			strings.push_back(cols[column]->slot() == Abstract::Column::Offset);
+		}
+
+		// Count rows from 'from' to 'to' on groups.
+		auto count = [this,&columns,&strings](size_t from, size_t to, Groups &groups) {
+
+			Iterator it{*this};
+
+			Key key(columns.size(),0);
+			Group *current = nullptr;
+
+			for(it.row = from; it.row < to; it.row++) {
+
+				const Row row{handler->rowptr(it)};
+
+				bool changed = (current == nullptr);
+				bool empty = false;
+				for(size_t ix = 0; ix < columns.size(); ix++) {
+					size_t slot = row[columns[ix]];
+					if(strings[ix] && !slot) {
+						empty = true;
+						break;
+					}
+					if(slot != key[ix]) {
+						key[ix] = slot;
+						changed = true;
+					}
+				}
+
+				if(empty) {
+					continue;
+				}
+
+				// Same values of the previous row, just count it.
+				if(changed) {
+					current = &groups[key];
+					if(!current->count) {
+						current->row = row;
+					}
+				}
+				current->count++;
+
+			}
+
+		};
+
+		Groups groups;
+		size_t length = handler->size();
+
+		// Concurrent aggregations share the cpus, don't oversubscribe them.
+		Workers workers{length / rows_per_thread};
+		size_t threads = workers.threads;
+
+		if(threads > 1) {
+
+			// Split rows between threads, then merge the results.
+			std::vector<Groups> partial(threads);
+			std::vector<std::thread> pool;
+
+			size_t step = (length + threads - 1) / threads;
+			for(size_t ix = 0; ix < threads; ix++) {
+				pool.emplace_back(count,ix * step,std::min(length,(ix+1) * step),std::ref(partial[ix]));
+			}
+
+			for(auto &worker : pool) {
+				worker.join();
+			}
+
+			groups = std::move(partial[0]);
+			for(size_t ix = 1; ix < partial.size(); ix++) {
+				for(auto &item : partial[ix]) {
+					Group &group{groups[item.first]};
+					if(!group.count) {
+						group.row = item.second.row;
+					}
+					group.count += item.second.count;
+				}
+			}
+
+		} else {
+
+			count(0,length,groups);
+
+		}
+
+		// Strings are case insensitive, merge the groups with the same folded text.
+		std::vector<Group> merged;
+		if(std::find(strings.begin(),strings.end(),true) == strings.end()) {
+
+			merged.reserve(groups.size());
+			for(const auto &item : groups) {
+				merged.push_back(item.second);
+			}
+
+		} else {
+
+			struct Folded {
+				Group group;
+				std::string text;	///< @brief The group values, as stored.
+				size_t rows = 0;	///< @brief Rows of the group variant.
+			};
+
+			std::unordered_map<std::string,Folded> folded;
+			for(const auto &item : groups) {
+
+				std::string text, key;
+				for(size_t ix = 0; ix < columns.size(); ix++) {
+					if(strings[ix]) {
+						text += cols[columns[ix]]->to_string(file,item.second.row);
+					} else {
+						text += std::to_string(item.first[ix]);
+					}
+					text += '\0';
+				}
+
+				key.reserve(text.size());
+				for(char chr : text) {
+					key += (char) std::tolower((unsigned char) chr);
+				}
+
+				// Report the values of the most used variant.
+				Folded &entry{folded[key]};
+				if(!entry.rows || item.second.count > entry.rows || (item.second.count == entry.rows && text < entry.text)) {
+					entry.group.row = item.second.row;
+					entry.text = text;
+					entry.rows = item.second.count;
+				}
+				entry.group.count += item.second.count;
+
+			}
+
+			merged.reserve(folded.size());
+			for(const auto &item : folded) {
+				merged.push_back(item.second.group);
+			}
+
+		}
+
+		// Sort the groups by column values.
+		std::vector<const Group *> sorted;
+		sorted.reserve(merged.size());
+		for(const Group &group : merged) {
+			sorted.push_back(&group);
+		}
+
+		std::sort(sorted.begin(),sorted.end(),[this,&columns](const Group *l, const Group *r){
+			for(uint16_t column : columns) {
+				if(cols[column]->less(file,l->row,r->row)) {
+					return true;
+				}
+				if(cols[column]->less(file,r->row,l->row)) {
+					return false;
+				}
+			}
+			return false;
+		});
+
+		// Start report
+		std::vector<std::string> column_names;
+		for(uint16_t column : columns) {
+			column_names.push_back(cols[column]->name());
+		}
+
+		if(counts) {
+			column_names.push_back("_count");
+		}
+
+		value.start(column_names);
+
+		size_t bytes = 0;
+		for(const Group *group : sorted) {
+			for(uint16_t column : columns) {
+				std::string text{cols[column]->to_string(file,group->row)};
+				bytes += text.size();
+				value.push_back(text);
+			}
+			if(counts) {
+				value.push_back(group->count);
+			}
+		}
+
+		debug("Aggregation of ",length," row(s) got ",sorted.size()," group(s)");
+		value.count(sorted.size());
+		QueryStatistics::served(sorted.size(),bytes);
+
+		return true;
+
+	}
+
+ }
@@ -82,4 +82,28 @@
 		return rc;
 	}
 
+	DataStore::Iterator & DataStore::Iterator::operator+=(size_t rows) {
+		return *this = (row + rows);
+	}
+
+	DataStore::Iterator DataStore::Iterator::operator+(size_t rows) const {
+		Iterator rc = *this;
+		rc += rows;
+		return rc;
+	}
+
+	DataStore::Iterator & DataStore::Iterator::operator-=(size_t rows) {
+		if(rows > row) {
+			throw out_of_range("Already at the first Iterator");
+		}
+		row -= rows;
+		return *this;
+	}
+
+	DataStore::Iterator DataStore::Iterator::operator-(size_t rows) const {
+		Iterator rc = *this;
+		rc -= rows;
+		return rc;
+	}
+
  }
@@ -0,0 +1,149 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements batch lookup.
+  */
+
+ #include <config.h>
+ #include <udjat/tools/datastore/iterator.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/logger.h>
+ #include <private/structs.h>
+ #include <private/iterator.h>
+ #include <algorithm>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	bool DataStore::Iterator::batch(std::vector<std::string> &keys, Udjat::Response::Table &value) const {
+
+		// Sort keys, just to walk the index forward; the search works on any order.
+		std::sort(keys.begin(),keys.end(),[](const std::string &l, const std::string &r){
+			return strcasecmp(l.c_str(),r.c_str()) < 0;
+		});
+		keys.erase(std::unique(keys.begin(),keys.end(),[](const std::string &l, const std::string &r){
+			return strcasecmp(l.c_str(),r.c_str()) == 0;
+		}),keys.end());
+
+		value.last_modified(file->get<Header>(0).last_modified);
+
+		// Start report
+		std::vector<std::string> column_names;
+
+		column_names.push_back("_key");
+		for(const auto &col : cols) {
+			column_names.push_back(col->name());
+		}
+
+		value.start(column_names);
+
+		DataStore::Iterator it{*this};
+		size_t length = handler->size();
+
+		auto comp = [&it](size_t row) {
+			it.row = row;
+			return it.handler->filter(it);
+		};
+
+		size_t items = 0;
+		size_t bytes = 0;
+		size_t position = 0;	// First entry of the previous match.
+
+		for(const std::string &key : keys) {
+
+			handler->key(key.c_str());
+
+			// Gallop from previous position to get the search window.
+			size_t from = 0, to = length;
+
+			if(position < length && comp(position) < 0) {
+
+				// Key is after the previous one, gallop forward.
+				from = position+1;
+				for(size_t step = 1;;step <<= 1) {
+					size_t probe = position+step;
+					if(probe >= length) {
+						break;
+					}
+					if(comp(probe) < 0) {
+						from = probe+1;
+					} else {
+						to = probe;
+						break;
+					}
+				}
+
+			} else {
+
+				// Key is before or at the previous one, gallop backward.
+				to = position;
+				for(size_t step = 1;step <= position;step <<= 1) {
+					size_t probe = position-step;
+					if(comp(probe) >= 0) {
+						to = probe;
+					} else {
+						from = probe+1;
+						break;
+					}
+				}
+
+			}
+
+			// Binary search for the first entry not before the key.
+			while(from < to) {
+				size_t center = from+((to-from)/2);
+				if(comp(center) < 0) {
+					from = center+1;
+				} else {
+					to = center;
+				}
+			}
+
+			position = from;
+
+			// Emit all entries equal to the key, the search matches it as a prefix.
+			for(size_t row = position; row < length && comp(row) == 0; row++) {
+
+				if(!it.handler->equal(it)) {
+					continue;
+				}
+
+				value.push_back(key);
+				for(size_t ix = 0; ix < cols.size(); ix++) {
+					std::string text{it[ix]};
+					bytes += text.size();
+					value.push_back(text);
+				}
+
+				items++;
+			}
+
+		}
+
+		debug("Batch of ",keys.size()," key(s) got ",items," row(s)");
+		value.count(items);
+		QueryStatistics::served(items,bytes);
+
+		return true;
+
+	}
+
+ }
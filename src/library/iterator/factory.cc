@@ -23,9 +23,11 @@
 
  #include <config.h>
  #include <udjat/tools/datastore/iterator.h>
+ #include <udjat/tools/datastore/column.h>
  #include <udjat/tools/logger.h>
  #include <private/structs.h>
  #include <private/iterator.h>
+ #include <private/bitmap.h>
  #include <udjat/tools/string.h>
 
  using namespace std;
@@ -55,6 +57,7 @@
 
 		// Build an agnostic iterator.
 		Iterator it{file,cols};
+		const char *expression = path;
 
 		// Check for column filter.
 		uint16_t column_id = (uint16_t) -1;
@@ -73,6 +76,40 @@
 			}
 		}
 
+		// Check for bitmap expression.
+		if( (column_id != (uint16_t) -1 && cols[column_id]->bitmap() && strncasecmp(path,"contains/",9)) || !strncasecmp(expression,"not/",4)) {
+
+			Bitmap selected{Bitmap::Factory(file,cols,expression)};
+			debug("Bitmap expression '",expression,"' has selected ",selected.count()," row(s)");
+
+			auto records = make_shared<CustomKeyHandler>(QueryStatistics::Bitmap);
+
+			it.handler = make_shared<PrimaryKeyHandler>(it);
+			selected.for_each([&it,&records](size_t row){
+				it = row;
+				records->push_back(it);
+			});
+
+			it.handler = records;
+			it = 0;
+			return it;
+
+		}
+
+		// Check for composite index.
+		if(column_id == (uint16_t) -1) {
+
+			const char *ptr = strchr(path,'/');
+			size_t offset = CompositeKeyHandler::find(file,(ptr ? string{path,(size_t) (ptr-path)} : string{path}).c_str());
+
+			if(offset) {
+				it.handler = make_shared<CompositeKeyHandler>(it,offset,ptr ? ptr+1 : "");
+				it = 0;
+				return it;
+			}
+
+		}
+
 		// It there's no handler, use the default one.
 		if(!it.handler) {
 			it.handler = make_shared<PrimaryKeyHandler>(it);
@@ -97,6 +134,10 @@
 					return row(it) == selected_row ? 0 : 1;
 				}
 
+				QueryStatistics::Kind kind() const noexcept override {
+					return QueryStatistics::Row;
+				}
+
 			};
 
 			it.handler = make_shared<Handler>(it,row);
@@ -104,25 +145,77 @@
 			return it;
 		}
 
+		if(column_id != (uint16_t) -1 && cols[column_id]->indexed()) {
+
+			// Check for range filters.
+			if(!strncasecmp(path,"range/",6)) {
+
+				path += 6;
+
+				const char *ptr = strchr(path,'/');
+				if(!ptr) {
+					throw runtime_error("Range filter requires both limits, use 'range/from/to'");
+				}
+
+				it.handler = make_shared<RangeKeyHandler>(it,column_id,string{path,(size_t) (ptr-path)}.c_str(),ptr+1);
+				it = 0;
+				return it;
+
+			}
+
+			if(!strncasecmp(path,"gt/",3)) {
+				it.handler = make_shared<RangeKeyHandler>(it,column_id,path+3,nullptr,false);
+				it = 0;
+				return it;
+			}
+
+			if(!strncasecmp(path,"lt/",3)) {
+				it.handler = make_shared<RangeKeyHandler>(it,column_id,nullptr,path+3,false);
+				it = 0;
+				return it;
+			}
+
+		}
+
 		if(!strncasecmp(path,"contains/",9)) {
 
 			// Search for partial content.
 			it = 0;
 			path += 9;
 
-			auto records = make_shared<CustomKeyHandler>();
+			auto records = make_shared<CustomKeyHandler>(QueryStatistics::Contains);
 
 			if(column_id != (uint16_t) -1) {
 
 				// Search for column contents
 				debug("Searching for substring '",path,"' on column '",cols[column_id]->name());
 
-				for(size_t row = 0; row < it.handler->size(); row++) {
-					it = row;
-					if(String::strcasestr(it[(size_t) column_id].c_str(),path)) {
-						debug("Selecting '",it[(size_t) column_id],"' rowptr=", ((size_t) it.rowptr())," size=");
-						records->push_back(it);
+				auto column = dynamic_cast<const Column<std::string> *>(cols[column_id].get());
+				if(column && column->dictionary()) {
+
+					// Test the dictionary once, then match the codes.
+					std::vector<bool> selected{column->select(file,[path](const char *value){
+						return String::strcasestr(value,path) != nullptr;
+					})};
+
+					for(size_t row = 0; row < it.handler->size(); row++) {
+						it = row;
+						size_t code = column->offset(it.rowptr());
+						if(code < selected.size() && selected[code]) {
+							records->push_back(it);
+						}
 					}
+
+				} else {
+
+					for(size_t row = 0; row < it.handler->size(); row++) {
+						it = row;
+						if(String::strcasestr(it[(size_t) column_id].c_str(),path)) {
+							debug("Selecting '",it[(size_t) column_id],"' row=",it.row);
+							records->push_back(it);
+						}
+					}
+
 				}
 
 			} else {
@@ -133,12 +226,12 @@
 				for(size_t row = 0; row < it.handler->size(); row++) {
 					for(size_t ix = 0;ix < cols.size();ix++) {
 						if(String::strcasestr(it[(size_t) ix].c_str(),path)) {
-							debug("Selecting '",it[(size_t) ix],"' rowptr=", ((size_t) it.rowptr()));
+							debug("Selecting '",it[(size_t) ix],"' row=",it.row);
 							records->push_back(it);
 							break;
 						}
 					}
-					it++;
+					++it;
 				}
 
 			}
@@ -150,6 +243,35 @@
 			return it;
 		}
 
+		if(column_id != (uint16_t) -1 && !cols[column_id]->indexed()) {
+
+			auto column = dynamic_cast<const Column<std::string> *>(cols[column_id].get());
+			if(column && column->dictionary()) {
+
+				// Equality filter on dictionary encoded column, resolve the code and scan the rows.
+				std::vector<bool> selected{column->select(file,[path](const char *value){
+					return strcasecmp(value,path) == 0;
+				})};
+
+				auto records = make_shared<CustomKeyHandler>(QueryStatistics::Scan);
+
+				for(size_t row = 0; row < it.handler->size(); row++) {
+					it = row;
+					size_t code = column->offset(it.rowptr());
+					if(code < selected.size() && selected[code]) {
+						records->push_back(it);
+					}
+				}
+
+				debug("Got ",records->size()," records");
+				it.handler = records;
+				it = 0;
+
+				return it;
+			}
+
+		}
+
 		// Use remaining path as search key.
 		it.handler->key(path);
 		it.search();
@@ -158,7 +280,19 @@
 	}
 
 	DataStore::Iterator DataStore::Iterator::Factory(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, const Request &request) {
-		return Factory(file,cols,request.path());
+
+		Iterator it{Factory(file,cols,request.path())};
+
+		String filter{request.getArgument("filter")};
+		if(!filter.empty()) {
+			const char *path = request.path();
+			while(*path && *path == '/') {
+				path++;
+			}
+			it.filter(filter.c_str(),!*path);
+		}
+
+		return it;
 	}
 
 
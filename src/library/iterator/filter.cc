@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements iterator filter.
+  */
+
+ #include <config.h>
+ #include <udjat/tools/datastore/iterator.h>
+ #include <udjat/tools/logger.h>
+ #include <private/iterator.h>
+ #include <private/filter.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	void DataStore::Iterator::filter(const char *expression, bool scan) {
+
+		Filter filter{file,cols,expression};
+
+		Iterator source{*this};
+		if(scan) {
+
+			// Entire table, use an index if possible.
+			auto indexed = filter.index();
+			if(indexed) {
+				source.handler = indexed;
+			}
+			source = 0;
+
+		}
+
+		auto records = make_shared<CustomKeyHandler>(QueryStatistics::Filter);
+
+		// Evaluate the filter in batches of rows.
+		std::vector<Row> rows;
+		rows.reserve(Filter::batch);
+		uint8_t selected[Filter::batch];
+
+		auto flush = [&filter,&rows,&selected,&records](){
+			filter.evaluate(rows.data(),rows.size(),selected);
+			for(size_t ix = 0; ix < rows.size(); ix++) {
+				if(selected[ix]) {
+					records->push_back(rows[ix]);
+				}
+			}
+			rows.clear();
+		};
+
+		while(source) {
+			rows.push_back(source.rowptr());
+			if(rows.size() == Filter::batch) {
+				flush();
+			}
+			++source;
+		}
+		flush();
+
+		debug("Filter '",expression,"' has selected ",records->size()," row(s)");
+
+		handler = records;
+		row = 0;
+
+	}
+
+ }
@@ -27,12 +27,19 @@
  #include <udjat/tools/logger.h>
  #include <private/structs.h>
  #include <private/iterator.h>
+ #include <udjat/tools/string.h>
+ #include <cstdio>
+ #include <cinttypes>
+
+ #ifndef ESTALE
+	#define ESTALE EINVAL
+ #endif // ESTALE
 
  using namespace std;
 
  namespace Udjat {
 
-	const size_t * DataStore::Iterator::rowptr() const {
+	DataStore::Row DataStore::Iterator::rowptr() const {
 		return handler->rowptr(*this);
 	}
 
@@ -43,9 +50,9 @@
 		}
 
 		std::string rc;
-		const size_t * cdata{rowptr()};
+		const Row cdata{rowptr()};
 
-		for(const auto col : cols) {
+		for(const auto &col : cols) {
 
 			if(col->key()) {
 				string str{col->to_string(file,cdata)};
@@ -63,7 +70,7 @@
 			return "";
 		}
 
-		for(auto col : cols) {
+		for(const auto &col : cols) {
 			if(!strcasecmp(col->name(),name)) {
 				std::string rc{col->to_string(file,rowptr())};
 				col->apply_layout(rc);
@@ -94,14 +101,19 @@
 			return value;
 		}
 
-		const size_t *row = rowptr();
-		for(auto col : cols) {
+		const Row row{rowptr()};
+		for(const auto &col : cols) {
 			col->get(file,row,value);
 		}
+		QueryStatistics::served(1,0);
 
 		return value;
 	}
 
+	DataStore::QueryStatistics::Kind DataStore::Iterator::kind() const noexcept {
+		return handler ? handler->kind() : QueryStatistics::Other;
+	}
+
 	size_t DataStore::Iterator::count() const {
 
 		size_t rc = 0;
@@ -110,7 +122,7 @@
 			DataStore::Iterator it{*this};
 			while(it) {
 				rc++;
-				it++;
+				++it;
 			}
 		}
 
@@ -130,6 +142,10 @@
 	}
 
 	bool DataStore::Iterator::get(Udjat::Response::Table &value) const {
+		return get(value,0);
+	}
+
+	bool DataStore::Iterator::get(Udjat::Response::Table &value, size_t limit) const {
 
 		DataStore::Iterator it{*this};
 		if(!it) {
@@ -142,16 +158,21 @@
 		std::vector<std::string> column_names;
 
 		column_names.push_back("_row");
-		for(auto col : cols) {
+		for(const auto &col : cols) {
 			column_names.push_back(col->name());
 		}
 
+		if(limit) {
+			column_names.push_back("_cursor");
+		}
+
 		value.start(column_names);
 
 		size_t items = 0;
-		while(it) {
+		size_t bytes = 0;
+		while(it && (!limit || items < limit)) {
 
-			for(auto col : column_names) {
+			for(const auto &col : column_names) {
 
 #ifdef DEBUG
 				if(!strcasecmp(col.c_str(),"_row")) {
@@ -160,16 +181,72 @@
 				}
 #endif // DEBUG
 
-				value.push_back(it[col.c_str()]);
+				if(limit && !strcasecmp(col.c_str(),"_cursor")) {
+					continue;
+				}
+
+				std::string text{it[col.c_str()]};
+				bytes += text.size();
+				value.push_back(text);
 			}
 
 			items++;
-			it++;
+			++it;
+
+			if(limit) {
+				// Cursor for the next row, empty when there's no more data.
+				value.push_back(it ? it.cursor() : std::string{});
+			}
+
 		}
 		value.count(items);
+		QueryStatistics::served(items,bytes);
 
 		return true;
 
+	}
+
+	bool DataStore::Iterator::get(const Request &request, Udjat::Response::Table &value) const {
+
+		DataStore::Iterator it{*this};
+
+		String cursor{request.getArgument("cursor")};
+		if(!cursor.empty()) {
+			it.cursor(cursor.c_str());
+		}
+
+		size_t offset = (size_t) strtoull(request.getArgument("offset","0").c_str(),NULL,10);
+		if(offset) {
+			it += offset;
+		}
+
+		return it.get(value,(size_t) strtoull(request.getArgument("limit","0").c_str(),NULL,10));
+
+	}
+
+	std::string DataStore::Iterator::cursor() const {
+		char buffer[40];
+		snprintf(buffer,sizeof(buffer),"%" PRIx64 ".%zx",file->get<Header>(0).generation,row);
+		return buffer;
+	}
+
+	void DataStore::Iterator::cursor(const char *cursor) {
+
+		uint64_t generation = 0;
+		size_t row = 0;
+		if(sscanf(cursor,"%" SCNx64 ".%zx",&generation,&row) != 2) {
+			throw std::system_error(EINVAL,std::system_category(),"Invalid cursor");
+		}
+
+		if(generation != file->get<Header>(0).generation) {
+			throw std::system_error(ESTALE,std::system_category(),"The cursor is from another store generation");
+		}
+
+		if(row < this->row) {
+			throw std::system_error(EINVAL,std::system_category(),"The cursor is out of the search range");
+		}
+
+		*this = row;
 
 	}
 
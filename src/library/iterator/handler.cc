@@ -24,6 +24,7 @@
  #include <config.h>
  #include <udjat/tools/datastore/iterator.h>
  #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/datastore/column.h>
  #include <private/iterator.h>
  #include <udjat/tools/logger.h>
  #include <stdexcept>
@@ -39,6 +40,14 @@
 	DataStore::Iterator::Handler::~Handler() {
 	}
 
+	DataStore::QueryStatistics::Kind DataStore::Iterator::Handler::kind() const noexcept {
+		return QueryStatistics::Other;
+	}
+
+	bool DataStore::Iterator::Handler::equal(const Iterator &it) const {
+		return filter(it) == 0;
+	}
+
 	uint16_t DataStore::Iterator::Handler::search_column_id(const Iterator &it, const char *colname) {
 
 		for(size_t c = 0; c < it.cols.size();c++) {
@@ -53,7 +62,9 @@
 
 	DataStore::PrimaryKeyHandler::PrimaryKeyHandler(const std::shared_ptr<DataStore::File> file, const char *s) : search_key{s} {
 		// Get pointer to primary index.
-		ixptr = file->get_ptr<size_t>(file->get<Header>(0).primary_offset);
+		const Header &header{file->get<Header>(0)};
+		ixptr = file->get_ptr<size_t>(header.primary_offset);
+		columnar = (header.columnar != 0);
 	}
 
 	DataStore::PrimaryKeyHandler::PrimaryKeyHandler(const Iterator &it, const char *s)
@@ -106,33 +117,46 @@
 		search_key = key;
 	}
 
+	DataStore::QueryStatistics::Kind DataStore::PrimaryKeyHandler::kind() const noexcept {
+		return QueryStatistics::Primary;
+	}
+
+	bool DataStore::PrimaryKeyHandler::equal(const Iterator &it) const {
+		return strcasecmp(it.primary_key().c_str(),search_key.c_str()) == 0;
+	}
+
 
-	const size_t * DataStore::PrimaryKeyHandler::rowptr(const Iterator &it) const {
+	DataStore::Row DataStore::PrimaryKeyHandler::rowptr(const Iterator &it) const {
 
 		if(row(it) > ixptr[0]) {
 			throw runtime_error(Logger::String{"Invalid row, should be from 0 to ",(int) ixptr[0]});
 		}
 
-		return ixptr + 1 + (row(it) * cols(it).size());
+		if(columnar) {
+			return Row{*file(it),row(it)};
+		}
+
+		return Row{ixptr + 1 + (row(it) * cols(it).size())};
 
 	}
 
-	const size_t * DataStore::ColumnKeyHandler::rowptr(const Iterator &it) const {
+	DataStore::Row DataStore::ColumnKeyHandler::rowptr(const Iterator &it) const {
 
 		if(row(it) > ixptr[0]) {
 			throw runtime_error(Logger::String{"Invalid row, should be from 0 to ",(int) ixptr[0]});
 		}
 
-		return file(it)->get_ptr<size_t>( *(ixptr + 1 + row(it)) );
+		return Row::Factory(*file(it), *(ixptr + 1 + row(it)) );
 
 	}
 
 	int DataStore::PrimaryKeyHandler::filter(const Iterator &it) const {
 
 		const char *key = search_key.c_str();
+		size_t keylen = search_key.size();
 
-		const size_t *row{rowptr(it)};
-		for(const auto col : cols(it)) {
+		const Row row{rowptr(it)};
+		for(const auto &col : cols(it)) {
 
 			if(col->key()) {
 
@@ -142,8 +166,6 @@
 
 				debug("col: '",value,"' key: '",key,"'");
 
-				size_t keylen = strlen(key);
-
 				if(keylen < value.size()) {
 
 					// The query string is smaller than the column, do a partial test.
@@ -161,7 +183,8 @@
 
 				// Get next block.
 				key += value.size();
-				if(!*key) {
+				keylen -= value.size();
+				if(!keylen) {
 					// Key is complete, found it.
 					return 0;
 				}
@@ -173,15 +196,279 @@
 
 	}
 
+	/// @brief Get the key column if it has a sorted dictionary.
+	static const DataStore::Column<std::string> * sorted_dictionary(const std::shared_ptr<DataStore::Abstract::Column> &col) {
+		auto column = dynamic_cast<const DataStore::Column<std::string> *>(col.get());
+		return (column && column->sorted()) ? column : nullptr;
+	}
+
+	/// @brief Compare dictionary code with the code range of a key.
+	static inline int comp_code(size_t code, size_t from, size_t to) noexcept {
+		if(code < from) {
+			return -1;
+		}
+		return code < to ? 0 : 1;
+	}
+
+	void DataStore::ColumnKeyHandler::key(const char *key) {
+		search_key = key;
+		parsed.valid = false;
+	}
+
+	DataStore::QueryStatistics::Kind DataStore::ColumnKeyHandler::kind() const noexcept {
+		return QueryStatistics::Index;
+	}
+
+	void DataStore::ColumnKeyHandler::parse(const Iterator &it) const {
+
+		const auto &col{cols(it)[colnumber]};
+
+		// Convert the search key once, to a code range on sorted dictionaries.
+		auto column = sorted_dictionary(col);
+		parsed.codes = (column != nullptr);
+		if(column) {
+			auto range = column->codes(file(it),search_key.c_str());
+			parsed.from = range.first;
+			parsed.to = range.second;
+		} else {
+			parsed.key = col->parse_key(search_key.c_str());
+		}
+
+		parsed.value = col->parse_key(search_key.c_str());
+		parsed.value.prefix = false;
+		parsed.valid = true;
+
+	}
+
 	int DataStore::ColumnKeyHandler::filter(const Iterator &it) const {
-		return cols(it)[colnumber]->comp(file(it),rowptr(it),search_key.c_str());
+
+		if(!parsed.valid) {
+			parse(it);
+		}
+
+		if(parsed.codes) {
+			return comp_code(rowptr(it)[colnumber],parsed.from,parsed.to);
+		}
+
+		return cols(it)[colnumber]->comp(file(it),rowptr(it),parsed.key);
+	}
+
+	bool DataStore::ColumnKeyHandler::equal(const Iterator &it) const {
+
+		if(!parsed.valid) {
+			parse(it);
+		}
+
+		return cols(it)[colnumber]->comp(file(it),rowptr(it),parsed.value) == 0;
+	}
+
+	size_t DataStore::ColumnKeyHandler::bound(const Iterator &it, const char *key, bool upper) const {
+
+		const auto &col{cols(it)[colnumber]};
+		const auto &file{this->file(it)};
+
+		// With sorted dictionaries, compare codes only; bounds are full values, not prefixes.
+		auto column = sorted_dictionary(col);
+		std::pair<size_t,size_t> range;
+		Abstract::Column::Key parsed;
+		if(column) {
+			range = column->codes(file,key,false);
+		} else {
+			parsed = col->parse_key(key);
+			parsed.prefix = false;
+		}
+
+		size_t from = 0;
+		size_t to = ixptr[0];
+
+		while(from < to) {
+
+			size_t center = from+((to-from)/2);
+			const Row row{Row::Factory(*file,ixptr[1+center])};
+			int comp{column ? comp_code(row[colnumber],range.first,range.second) : col->comp(file,row,parsed)};
+
+			if(comp < 0 || (upper && comp == 0)) {
+				from = center+1;
+			} else {
+				to = center;
+			}
+
+		}
+
+		return from;
+	}
+
+	DataStore::RangeKeyHandler::RangeKeyHandler(const Iterator &it, uint16_t c, const char *from, const char *to, bool inclusive)
+		: ColumnKeyHandler{it,c} {
+
+		first = (from && *from) ? bound(it,from,!inclusive) : 0;
+		last = (to && *to) ? bound(it,to,inclusive) : ixptr[0];
+
+		if(last < first) {
+			last = first;
+		}
+
+		debug("Range has ",(last-first)," entries (",first," to ",last,")");
+
+	}
+
+	DataStore::Row DataStore::RangeKeyHandler::rowptr(const Iterator &it) const {
+
+		if(row(it) >= size()) {
+			throw runtime_error(Logger::String{"Invalid row, should be from 0 to ",(int) size()});
+		}
+
+		return Row::Factory(*file(it), *(ixptr + 1 + first + row(it)) );
+
+	}
+
+	int DataStore::RangeKeyHandler::filter(const Iterator &) const {
+		return 0;
+	}
+
+	size_t DataStore::RangeKeyHandler::size() const {
+		return last - first;
+	}
+
+	void DataStore::RangeKeyHandler::key(const char *) {
+		throw logic_error("Cant set key on range handler");
+	}
+
+	DataStore::QueryStatistics::Kind DataStore::RangeKeyHandler::kind() const noexcept {
+		return QueryStatistics::Range;
+	}
+
+	size_t DataStore::CompositeKeyHandler::find(const std::shared_ptr<DataStore::File> file, const char *name) {
+
+		const Header &header{file->get<Header>(0)};
+		const Section *section{file->get_ptr<Section>(header.sections.offset)};
+
+		for(size_t ix = 0; ix < header.sections.count; ix++) {
+			if(section->type == Section::Composite && !strcasecmp(file->get_ptr<char>(file->get<CompositeIndex>(section->offset).name),name)) {
+				return section->offset;
+			}
+			section++;
+		}
+
+		return 0;
+	}
+
+	DataStore::CompositeKeyHandler::CompositeKeyHandler(const Iterator &it, size_t offset, const char *path) {
+
+		const CompositeIndex &cindex{file(it)->get<CompositeIndex>(offset)};
+
+		qtdcols = cindex.columns;
+		columns = file(it)->get_ptr<uint16_t>(offset+sizeof(CompositeIndex));
+		ixptr = (const size_t *) (columns+qtdcols);
+
+		// Split and convert search keys.
+		std::vector<Abstract::Column::Key> keys;
+		while(path && *path) {
+
+			if(keys.size() >= qtdcols) {
+				throw runtime_error(Logger::String{"Too many keys, index has only ",(unsigned int) qtdcols," column(s)"});
+			}
+
+			const auto &col{cols(it)[columns[keys.size()]]};
+
+			const char *ptr = strchr(path,'/');
+			if(!ptr) {
+				keys.push_back(col->parse_key(path));
+				break;
+			}
+			keys.push_back(col->parse_key(string{path,(size_t) (ptr-path)}.c_str()));
+			path = ptr+1;
+		}
+
+		// Search for the first entry not before the keys.
+		{
+			size_t from = 0, to = ixptr[0];
+			while(from < to) {
+				size_t center = from+((to-from)/2);
+				if(comp(it,center,keys) < 0) {
+					from = center+1;
+				} else {
+					to = center;
+				}
+			}
+			first = from;
+		}
+
+		// Search for the first entry after the keys.
+		{
+			size_t from = first, to = ixptr[0];
+			while(from < to) {
+				size_t center = from+((to-from)/2);
+				if(comp(it,center,keys) <= 0) {
+					from = center+1;
+				} else {
+					to = center;
+				}
+			}
+			last = from;
+		}
+
+		debug("Composite selection has ",(last-first)," entries (",first," to ",last,")");
+
+	}
+
+	int DataStore::CompositeKeyHandler::comp(const Iterator &it, size_t entry, const std::vector<Abstract::Column::Key> &keys) const {
+
+		const auto &file{this->file(it)};
+		const Row row{Row::Factory(*file,ixptr[1+entry])};
+
+		for(size_t ix = 0; ix < keys.size(); ix++) {
+
+			const auto &col{cols(it)[columns[ix]]};
+
+			int rc;
+			if(ix+1 < keys.size() && !col->length()) {
+				// Leading string keys requires full match.
+				rc = strcasecmp(col->to_string(file,row).c_str(),keys[ix].text.c_str());
+			} else {
+				rc = col->comp(file,row,keys[ix]);
+			}
+
+			if(rc) {
+				return rc;
+			}
+
+		}
+
+		return 0;
+	}
+
+	DataStore::Row DataStore::CompositeKeyHandler::rowptr(const Iterator &it) const {
+
+		if(row(it) >= size()) {
+			throw runtime_error(Logger::String{"Invalid row, should be from 0 to ",(int) size()});
+		}
+
+		return Row::Factory(*file(it), *(ixptr + 1 + first + row(it)) );
+
+	}
+
+	int DataStore::CompositeKeyHandler::filter(const Iterator &) const {
+		return 0;
+	}
+
+	size_t DataStore::CompositeKeyHandler::size() const {
+		return last - first;
+	}
+
+	void DataStore::CompositeKeyHandler::key(const char *) {
+		throw logic_error("Cant set key on composite index handler");
+	}
+
+	DataStore::QueryStatistics::Kind DataStore::CompositeKeyHandler::kind() const noexcept {
+		return QueryStatistics::Composite;
 	}
 
 	void DataStore::CustomKeyHandler::push_back(const Iterator &it) {
 		records.push_back(handler(it)->rowptr(it));
 	}
 
-	const size_t * DataStore::CustomKeyHandler::rowptr(const Iterator &it) const {
+	DataStore::Row DataStore::CustomKeyHandler::rowptr(const Iterator &it) const {
 
 		size_t row{this->row(it)};
 
@@ -189,7 +476,7 @@
 			throw runtime_error(Logger::String{"Invalid row ",row,", should be from 0 to ",(int) (records.size()-1)});
 		}
 
-		debug("row=",row," rowptr=",((size_t)records[row])," max=",records.size());
+		debug("row=",row," max=",records.size());
 
 		return records[row];
 
@@ -207,6 +494,10 @@
 		throw logic_error("Cant set key on custom handler");
 	}
 
+	DataStore::QueryStatistics::Kind DataStore::CustomKeyHandler::kind() const noexcept {
+		return selection;
+	}
+
 	/*
 	void DataStore::Iterator::set_default_index(const std::string &search_key) {
 
@@ -226,7 +517,7 @@
 				const char *key = search_key.c_str();
 
 				const size_t *row{it.rowptr()};
-				for(const auto col : it.cols) {
+				for(const auto &col : it.cols) {
 
 					if(col->key()) {
 
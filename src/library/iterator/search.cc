@@ -21,8 +21,6 @@
   * @brief Implement iterator search for key.
   */
 
- #include <config.h>
-
  #include <config.h>
  #include <udjat/tools/datastore/iterator.h>
  #include <udjat/tools/logger.h>
@@ -34,54 +32,31 @@
 
 	void DataStore::Iterator::search() {
 
+		// Binary search for the first entry not before the key.
 		size_t from = 0;
 		size_t to = handler->size();
 
-		while( (to - from) > 1 ) {
+		while(from < to) {
 
 			row = from+((to-from)/2);
-			debug("Center row=",row," from=",from," to=",to, " to-from=",(to-from));
-
-			int comp{handler->filter(*this)};
-
-			debug("comp=",comp);
-
-			if(comp == 0) {
-
-				// Found!
-
-				debug("Found ",primary_key()," at row ",row);
-
-				// Go down until the first occurrence (Just in case).
-				size_t first_row = row;
-				while(row > 1) {
-					row--;
-					if(handler->filter(*this)) {
-						break;
-					} else {
-						first_row = row;
-					}
-				}
-				row = first_row;
-
-				debug("Final result was ",primary_key()," at row ",row);
-
-				return;
-
-			} else if(comp < 0) {
+			debug("Center row=",row," from=",from," to=",to);
 
+			if(handler->filter(*this) < 0) {
 				// Current is lower, get highest values
-				from = row;
-
+				from = row+1;
 			} else {
-
-				// Current is bigger, get lower values
+				// Current is equal or bigger, get lower values
 				to = row;
-
 			}
 
 		}
 
+		row = from;
+		if(row < handler->size() && handler->filter(*this) == 0) {
+			debug("Found ",primary_key()," at row ",row);
+			return;
+		}
+
 		debug(__FUNCTION__," has failed");
 		row = handler->size();
 
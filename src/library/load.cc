@@ -27,9 +27,24 @@
  #include <udjat/tools/file.h>
  #include <udjat/tools/logger.h>
  #include <private/structs.h>
+ #include <private/compressor.h>
+ #include <private/bitmap.h>
  #include <regex>
  #include <set>
+ #include <algorithm>
+ #include <unordered_map>
+ #include <map>
+ #include <atomic>
+ #include <climits>
+ #include <chrono>
+ #include <cstdint>
+ #include <random>
  #include <udjat/tools/datastore/column.h>
+ #include <udjat/tools/datastore/row.h>
+
+ #ifndef _WIN32
+	#include <sys/resource.h>
+ #endif // _WIN32
 
  using namespace std;
 
@@ -67,9 +82,24 @@
 
 	}
 
-	shared_ptr<DataStore::File> DataStore::Loader::Abstract::load() {
+	time_t DataStore::Loader::Abstract::last_modified() const noexcept {
+
+		time_t rc = 0;
+
+#ifndef _WIN32
+		for(auto &f : files) {
+			if(rc < (time_t) f.st.st_mtim.tv_sec) {
+				rc = (time_t) f.st.st_mtim.tv_sec;
+			}
+		}
+#endif // _WIN32
+
+		return rc;
+	}
+
+	shared_ptr<DataStore::File> DataStore::Loader::Abstract::load(const char *filename) {
 
-		shared_ptr<File> file{make_shared<File>()};
+		shared_ptr<File> file{filename ? make_shared<File>(filename) : make_shared<File>()};
 
 		if(file->size()) {
 			throw runtime_error("Datastore is not empty");
@@ -82,6 +112,15 @@
 		DataStore::Header header;
 		memset(&header,0,sizeof(header));
 		header.updated = time(0);
+
+		stats = LoadStatistics{};
+		stats.started = header.updated;
+		{
+			// Build time on the high bits, a random per process nonce plus a counter on the low ones;
+			// cursors from a previous run, even on the same second, are not accepted.
+			static std::atomic<uint32_t> generation{(uint32_t) std::random_device{}()};
+			header.generation = (((uint64_t) header.updated) << 32) | (uint64_t) (++generation);
+		}
 		header.columns = container.columns().size();
 		file->write(header);
 
@@ -104,9 +143,109 @@
 
 			file->write(f.name.c_str(),f.name.size()+1);
 			file->write(&timestamp,sizeof(timestamp));
+
+			stats.sources.files++;
+			stats.sources.bytes += (size_t) f.st.st_size;
 		}
 		file->write("\0",1);
 
+		// Train symbol tables for compressed columns.
+		std::vector<std::shared_ptr<Compressor>> compressors(container.columns().size());
+		{
+			/// @brief Collect sample strings from the first rows of all sources.
+			class Sampler : public DataStore::Loader::Abstract::Context {
+			private:
+				const Container &container;
+				std::vector<std::vector<std::string>> &samples;
+				std::vector<size_t> lengths;
+				std::vector<size_t> map;	///< @brief Source column for each compressed column.
+				const size_t limit = 16384;	///< @brief Sample length for each column (in bytes).
+
+			public:
+
+				Sampler(const Container &c, std::vector<std::vector<std::string>> &s) : container{c}, samples{s}, lengths(s.size(),0) {
+				}
+
+				void open(const std::vector<String> &fromcols) override {
+					map.assign(container.columns().size(),(size_t) -1);
+					for(size_t from = 0; from < fromcols.size(); from++) {
+						size_t to = container.column_index(fromcols[from].c_str());
+						if(to != ((size_t) -1) && lengths[to] < limit) {
+							auto column = dynamic_cast<const Column<std::string> *>(container.columns()[to].get());
+							if(column && column->compressed()) {
+								map[to] = from;
+							}
+						}
+					}
+				}
+
+				void append(std::vector<String> &values) override {
+					for(size_t to = 0; to < map.size(); to++) {
+						if(map[to] < values.size() && lengths[to] < limit) {
+							samples[to].push_back(values[map[to]].strip());
+							lengths[to] += samples[to].back().size();
+						}
+					}
+				}
+
+				bool complete() const override {
+					for(size_t to = 0; to < map.size(); to++) {
+						if(map[to] != ((size_t) -1) && lengths[to] < limit) {
+							return false;
+						}
+					}
+					return true;
+				}
+
+				/// @brief Check if the samples of all compressed columns are complete.
+				bool full() const {
+					for(size_t to = 0; to < lengths.size(); to++) {
+						auto column = dynamic_cast<const Column<std::string> *>(container.columns()[to].get());
+						if(column && column->compressed() && lengths[to] < limit) {
+							return false;
+						}
+					}
+					return true;
+				}
+
+			};
+
+			bool compressed = false;
+			for(const auto &col : container.columns()) {
+				auto column = dynamic_cast<const Column<std::string> *>(col.get());
+				if(column && column->compressed()) {
+					compressed = true;
+				}
+			}
+
+			if(compressed) {
+
+				LoadStatistics::Timer timer{stats,*file,"symbols"};
+				std::vector<std::vector<std::string>> samples(container.columns().size());
+				Sampler sampler{container,samples};
+				for(auto &f : files) {
+					if(sampler.full()) {
+						break;
+					}
+					load_file(sampler,f.name.c_str());
+				}
+
+				std::vector<size_t> tables(container.columns().size(),0);
+				for(size_t col = 0; col < container.columns().size(); col++) {
+					auto column = dynamic_cast<const Column<std::string> *>(container.columns()[col].get());
+					if(column && column->compressed()) {
+						Logger::String{"Training symbol table for '",column->name(),"' with ",samples[col].size()," sample(s)"}.trace(container.id());
+						compressors[col] = make_shared<Compressor>(samples[col]);
+						tables[col] = file->write(compressors[col]->symbols());
+					}
+				}
+
+				header.symbols = file->write(tables.data(),tables.size() * sizeof(size_t));
+
+			}
+
+		}
+
 		// Create primary index
 		// https://stackoverflow.com/questions/14896032/c11-stdset-lambda-comparison-function
 		class IndexEntry {
@@ -169,6 +308,8 @@
 			const Container &container;
 			set<IndexEntry,decltype(comp)> &index;
 			Deduplicator &deduplicator;
+			const std::vector<std::shared_ptr<Compressor>> &compressors;
+			LoadStatistics &stats;
 			// vector<shared_ptr<DataStore::Abstract::Column>> columns;
 
 			struct Map {
@@ -180,7 +321,8 @@
 			std::vector<Map> map;
 
 		public:
-			Context(const Container &c, std::set<IndexEntry,decltype(comp)> &i, Deduplicator &d) : container{c}, index{i}, deduplicator{d} {
+			Context(const Container &c, std::set<IndexEntry,decltype(comp)> &i, Deduplicator &d, const std::vector<std::shared_ptr<Compressor>> &z, LoadStatistics &s)
+				: container{c}, index{i}, deduplicator{d}, compressors{z}, stats{s} {
 			}
 
 			void open(const std::vector<String> &fromcols) override {
@@ -201,11 +343,20 @@
 				auto &tocols{container.columns()};
 				IndexEntry record{tocols.size()};
 
+				auto started = std::chrono::steady_clock::now();
+
 				// Parse fields
 				for(const auto &item : map) {
-					record.data[item.to] = tocols[item.to]->save(deduplicator, values[item.from].strip().c_str());
+					if(compressors[item.to]) {
+						record.data[item.to] = deduplicator.insert(compressors[item.to]->encode(values[item.from].strip().c_str()).c_str());
+					} else {
+						record.data[item.to] = tocols[item.to]->save(deduplicator, values[item.from].strip().c_str());
+					}
 				}
 
+				auto converted = std::chrono::steady_clock::now();
+				stats.sources.convert += std::chrono::duration<double>(converted - started).count();
+
 				// Search
 				auto idata = index.find(record);
 				if(idata == index.end()) {
@@ -224,35 +375,251 @@
 						}
 					}
 				}
+
+				stats.sources.insert += std::chrono::duration<double>(std::chrono::steady_clock::now() - converted).count();
+				stats.sources.rows++;
+
 			}
 
 		};
 
 		// Load files.
 		{
+			LoadStatistics::Timer timer{stats,*file,"sources"};
 			for(auto &f : files) {
 				Logger::String{"Loading ",f.name.c_str()}.info(container.id());
-				Context context{container, index, dedup};
+				Context context{container, index, dedup, compressors, stats};
 				load_file(context,f.name.c_str());
 			}
 		}
 
+		// Build dictionaries, replace the string offsets with sequential codes.
+		{
+			LoadStatistics::Timer timer{stats,*file,"dictionaries"};
+			std::vector<size_t> dictionaries(container.columns().size(),0);
+			bool encoded = false;
+
+			for(size_t col = 0; col < container.columns().size(); col++) {
+
+				auto column = dynamic_cast<const Column<std::string> *>(container.columns()[col].get());
+				if(!(column && column->dictionary())) {
+					continue;
+				}
+
+				Logger::String{"Encoding '",column->name(),"'"}.trace(container.id());
+
+				// Get distinct values.
+				std::unordered_map<size_t,size_t> codes;
+				std::vector<size_t> offsets;
+
+				for(auto &it : index) {
+					size_t value = it.data[col];
+					if(value && codes.emplace(value,0).second) {
+						offsets.push_back(value);
+					}
+				}
+
+				if(column->sorted()) {
+
+					// Order preserving codes, sort the distinct values (case-folded).
+					std::vector<std::pair<std::string,size_t>> values;
+					values.reserve(offsets.size());
+					for(size_t offset : offsets) {
+						values.emplace_back(file->read(offset),offset);
+					}
+
+					std::sort(values.begin(),values.end(),[](const std::pair<std::string,size_t> &l, const std::pair<std::string,size_t> &r){
+						int rc = strcasecmp(l.first.c_str(),r.first.c_str());
+						return rc ? rc < 0 : strcmp(l.first.c_str(),r.first.c_str()) < 0;
+					});
+
+					for(size_t ix = 0; ix < values.size(); ix++) {
+						offsets[ix] = values[ix].second;
+					}
+
+				}
+
+				// Code 0 is the empty string, the first value gets code 1.
+				for(size_t ix = 0; ix < offsets.size(); ix++) {
+					codes[offsets[ix]] = ix+1;
+				}
+
+				for(auto &it : index) {
+					size_t &value = it.data[col];
+					if(value) {
+						value = codes[value];
+					}
+				}
+
+				if(offsets.size() > UINT32_MAX) {
+					throw runtime_error(Logger::String{"Too many distinct values on column '",column->name(),"'"});
+				}
+
+				size_t qtdcodes = offsets.size();
+				dictionaries[col] = file->write(qtdcodes);
+				file->write(offsets.data(),offsets.size() * sizeof(size_t));
+				encoded = true;
+
+				debug("Column '",column->name(),"' has ",qtdcodes," distinct value(s)");
+
+			}
+
+			if(encoded) {
+				header.dictionaries = file->write(dictionaries.data(),dictionaries.size() * sizeof(size_t));
+			}
+
+		}
+
 		// Write primary index.
-		vector<size_t> records;	///< @brief The offset of the data records (for secondary indexes).
+		vector<size_t> records;	///< @brief The id of the data records (for secondary indexes).
 		{
+			LoadStatistics::Timer timer{stats,*file,"primary"};
 			Logger::String{"Writing primary index"}.trace(container.id());
 
 			size_t qtdrec = index.size();
 			header.primary_offset = file->write(qtdrec);
 
-			for(auto &it : index) {
-				records.push_back(file->write(it.data,it.length * sizeof(it.data[0])));
+			if(container.columnar()) {
+
+				// Columnar layout, one dense array for each column, records are the row numbers.
+				std::vector<Row::Array> arrays;
+
+				for(size_t col = 0; col < container.columns().size(); col++) {
+
+					Row::Array array;
+					memset(&array,0,sizeof(array));
+
+					size_t max = 0;
+					for(auto &it : index) {
+						if(it.data[col] > max) {
+							max = it.data[col];
+						}
+					}
+					if(max <= UINT8_MAX) {
+						array.width = sizeof(uint8_t);
+					} else if(max <= UINT16_MAX) {
+						array.width = sizeof(uint16_t);
+					} else if(max <= UINT32_MAX) {
+						array.width = sizeof(uint32_t);
+					} else {
+						array.width = sizeof(size_t);
+					}
+
+					// Align array on value width.
+					{
+						static const size_t zero = 0;
+						size_t pad = file->size() % array.width;
+						if(pad) {
+							file->write(&zero,array.width - pad);
+						}
+					}
+
+					// Store the low order bytes of each value.
+					std::vector<uint8_t> buffer(qtdrec * array.width);
+					uint8_t *ptr = buffer.data();
+					for(auto &it : index) {
+						switch(array.width) {
+						case sizeof(uint8_t):
+							*ptr = (uint8_t) it.data[col];
+							break;
+
+						case sizeof(uint16_t):
+							{
+								uint16_t value = (uint16_t) it.data[col];
+								memcpy(ptr,&value,sizeof(value));
+							}
+							break;
+
+						case sizeof(uint32_t):
+							{
+								uint32_t value = (uint32_t) it.data[col];
+								memcpy(ptr,&value,sizeof(value));
+							}
+							break;
+
+						default:
+							memcpy(ptr,&it.data[col],sizeof(size_t));
+						}
+						ptr += array.width;
+					}
+					array.offset = file->write(buffer.data(),buffer.size());
+
+					debug("Column '",container.columns()[col]->name(),"' width=",(unsigned int) array.width);
+					arrays.push_back(array);
+
+				}
+
+				header.columnar = file->write(arrays.data(),arrays.size() * sizeof(Row::Array));
+
+				for(size_t row = 0; row < qtdrec; row++) {
+					records.push_back(row);
+				}
+
+			} else {
+
+				for(auto &it : index) {
+					records.push_back(file->write(it.data,it.length * sizeof(it.data[0])));
+				}
+
+			}
+
+			// Update header, required by the row accessor.
+			file->write(0, header);
+
+		}
+
+		std::vector<struct Section> sections;
+
+		// Build & write bitmap indexes, the bitmaps are selecting primary index rows.
+		for(size_t col = 0; col < container.columns().size(); col++) {
+
+			if(!container.columns()[col]->bitmap()) {
+				continue;
 			}
 
+			LoadStatistics::Timer timer{stats,*file,"bitmaps"};
+			Logger::String{"Building bitmap index for '",container.columns()[col]->name(),"'"}.trace(container.id());
+
+			// Get rows for each value, ignore rows with empty strings (offset 0); on inline values 0 is a value.
+			const bool strings = (container.columns()[col]->slot() == DataStore::Abstract::Column::Offset);
+			std::map<size_t,std::vector<size_t>> values;
+			{
+				file->map();
+				for(size_t row = 0; row < records.size(); row++) {
+					size_t value = Row::Factory(*file,records[row])[col];
+					if(value || !strings) {
+						values[value].push_back(row);
+					}
+				}
+				file->unmap();
+			}
+
+			std::vector<BitmapValue> entries;
+			for(const auto &value : values) {
+				BitmapValue entry;
+				memset(&entry,0,sizeof(entry));
+				entry.record = records[value.second[0]];
+				entry.offset = Bitmap::write(*file,value.second);
+				entries.push_back(entry);
+			}
+
+			struct Section section;
+			memset(&section,0,sizeof(section));
+			section.type = Section::Bitmap;
+			section.id = (uint16_t) col;
+
+			size_t qtdvalues = entries.size();
+			section.offset = file->write(qtdvalues);
+			file->write(entries.data(),entries.size() * sizeof(BitmapValue));
+
+			debug("Wrote ",qtdvalues," bitmap(s) for column '",container.columns()[col]->name(),"'");
+			sections.push_back(section);
+
 		}
 
 		// Build & write column indexes.
 		{
+			LoadStatistics::Timer timer{stats,*file,"indexes"};
 			std::vector<struct Index> indexes;
 
 			for(size_t ix = 0; ix < container.columns().size(); ix++) {
@@ -265,34 +632,32 @@
 					memset(&idx,0,sizeof(idx));
 					idx.column = (uint16_t) ix;
 
-					// Sort entries
+					// Sort entries, ignore rows with empty strings (offset 0); on inline values 0 is a value.
+					const bool strings = (container.columns()[ix]->slot() == DataStore::Abstract::Column::Offset);
+					std::vector<size_t> entries;
 					{
 						file->map();
-						size_t off = ix*sizeof(size_t);
 						std::sort(records.begin(),records.end(),
-							[this,file,ix,off](size_t l, size_t h){
+							[this,file,ix](size_t l, size_t h){
 
-								return container.columns()[ix]->less(file,file->get_ptr<size_t>(l),file->get_ptr<size_t>(h));
+								return container.columns()[ix]->less(file,Row::Factory(*file,l),Row::Factory(*file,h));
 
 							}
 						);
+						entries.reserve(records.size());
+						for(size_t record : records) {
+							if(!strings || Row::Factory(*file,record)[ix]) {
+								entries.push_back(record);
+							}
+						}
 						file->unmap();
 					}
 
-					// Write index, ignore rows with empty column (record[ix] = 0)
+					// Write index.
 					{
-						size_t qtdrec = 0;
+						size_t qtdrec = entries.size();
 						idx.offset = file->write(qtdrec);
-						size_t off = ix*sizeof(size_t);
-						for(size_t record : records) {
-							size_t v = 0;
-							file->read(record+off,&v,sizeof(v));
-							if(v) {
-								qtdrec++;
-								file->write(&record,sizeof(record));
-							}
-						}
-						file->write(idx.offset,&qtdrec,sizeof(qtdrec));
+						file->write(entries.data(),entries.size() * sizeof(size_t));
 						debug("Wrote ",qtdrec," entries on index");
 					}
 
@@ -330,9 +695,131 @@
 
 		}
 
+		// Build & write composite indexes.
+		{
+			LoadStatistics::Timer timer{stats,*file,"composites"};
+			uint16_t id = 0;
+			for(const auto &composite : container.composite_indexes()) {
+
+				Logger::String{"Indexing by '",composite.name,"'"}.trace(container.id());
+
+				const auto &cols{container.columns()};
+
+				// Sort entries (lexicographic by key columns), ignore rows with empty first key column.
+				std::vector<size_t> entries;
+				{
+					file->map();
+					std::sort(records.begin(),records.end(),
+						[file,&cols,&composite](size_t l, size_t h){
+
+							const Row lrow{Row::Factory(*file,l)};
+							const Row rrow{Row::Factory(*file,h)};
+
+							for(uint16_t column : composite.columns) {
+								if(cols[column]->less(file,lrow,rrow)) {
+									return true;
+								}
+								if(cols[column]->less(file,rrow,lrow)) {
+									return false;
+								}
+							}
+
+							return false;
+
+						}
+					);
+					entries.reserve(records.size());
+					for(size_t record : records) {
+						if(Row::Factory(*file,record)[composite.columns[0]]) {
+							entries.push_back(record);
+						}
+					}
+					file->unmap();
+				}
+
+				struct Section section;
+				memset(&section,0,sizeof(section));
+				section.type = Section::Composite;
+				section.id = id++;
+
+				// Write section header.
+				{
+					struct CompositeIndex cindex;
+					memset(&cindex,0,sizeof(cindex));
+					cindex.name = file->write(composite.name);
+					cindex.columns = (uint16_t) composite.columns.size();
+
+					section.offset = file->write(&cindex,sizeof(cindex));
+					for(uint16_t column : composite.columns) {
+						file->write(column);
+					}
+				}
+
+				// Write index.
+				{
+					size_t qtdrec = entries.size();
+					file->write(qtdrec);
+					file->write(entries.data(),entries.size() * sizeof(size_t));
+					debug("Wrote ",qtdrec," entries on composite index");
+				}
+
+				sections.push_back(section);
+
+			}
+
+		}
+
+		// Build & write api-call sections.
+		{
+			LoadStatistics::Timer timer{stats,*file,"api-calls"};
+			uint16_t id = 0;
+			for(const auto &query : container.api_calls()) {
+
+				struct Section section;
+				memset(&section,0,sizeof(section));
+				section.type = Section::ApiCall;
+				section.id = id++;
+				section.offset = query->build(container.columns(),file,records);
+
+				if(section.offset) {
+					sections.push_back(section);
+				}
+
+			}
+
+		}
+
+		// Write data sections list.
+		{
+			header.sections.count = sections.size();
+			header.sections.offset = file->size();
+			for(struct Section &it : sections) {
+				file->write(&it,sizeof(struct Section));
+			}
+
+		}
+
 		// Write updated header
 		file->write(0, header);
 
+		stats.records = index.size();
+		stats.length = file->size();
+		stats.dedup.lookups = dedup.inserted();
+		stats.dedup.hits = dedup.found();
+		stats.dedup.saved = dedup.saved();
+		stats.dedup.blocks = dedup.size();
+
+#ifndef _WIN32
+		{
+			struct rusage usage;
+			if(!getrusage(RUSAGE_SELF,&usage)) {
+				stats.process_peak_rss = (size_t) usage.ru_maxrss;
+			}
+		}
+#endif // _WIN32
+
+		container.statistics(stats);
+
 		// Return new data storage.
 		debug("Records: ",index.size());
 
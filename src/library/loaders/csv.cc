@@ -88,7 +88,7 @@
 		}
 
 		// Read csv contents.
-		while(std::getline(infile, line)) {
+		while(!context.complete() && std::getline(infile, line)) {
 
 			line.strip();
 			if(line.empty()) {
@@ -0,0 +1,220 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the memory accounting of the active store.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/container.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/logger.h>
+ #include <private/structs.h>
+ #include <algorithm>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Get the length of a bitmap index section.
+	/// @param first Updated with the lowest offset of the bitmap data.
+	static size_t bitmap_length(const DataStore::File &file, size_t offset, size_t &first) {
+
+		size_t qtdvalues = file.get<size_t>(offset);
+		const DataStore::BitmapValue *values = file.get_ptr<DataStore::BitmapValue>(offset+sizeof(size_t));
+
+		size_t length = sizeof(size_t) + (qtdvalues * sizeof(DataStore::BitmapValue));
+
+		for(size_t value = 0; value < qtdvalues; value++) {
+
+			first = std::min(first,values[value].offset);
+
+			size_t count = file.get<size_t>(values[value].offset);
+			const DataStore::BitmapContainer *containers = file.get_ptr<DataStore::BitmapContainer>(values[value].offset+sizeof(size_t));
+
+			length += sizeof(size_t) + (count * sizeof(DataStore::BitmapContainer));
+
+			for(size_t container = 0; container < count; container++) {
+				first = std::min(first,containers[container].offset);
+				if(containers[container].cardinality > 4096) {
+					length += 1024 * sizeof(uint64_t);
+				} else {
+					length += containers[container].cardinality * sizeof(uint16_t);
+				}
+			}
+
+		}
+
+		return length;
+
+	}
+
+	DataStore::MemoryStatistics DataStore::Container::memory_usage() const {
+
+		MemoryStatistics stats;
+
+		{
+			std::lock_guard<std::mutex> lock{generations.guard};
+			generations.files.erase(
+				std::remove_if(generations.files.begin(),generations.files.end(),[](const std::weak_ptr<File> &file){
+					return file.expired();
+				}),
+				generations.files.end()
+			);
+			stats.generations = generations.files.size();
+		}
+
+		{
+			auto builds{statistics()};
+			if(!builds.empty()) {
+				stats.deduplicated = builds.front().dedup.saved;
+			}
+		}
+
+		auto file{snapshot()};
+		if(!file) {
+			return stats;
+		}
+
+		if(stats.generations) {
+			stats.pinned = stats.generations - 1;	// The active one is not pinned.
+		}
+
+		stats.length = file->size();
+
+		try {
+			stats.resident = file->resident();
+		} catch(const std::exception &e) {
+			Logger::String{"Unable to get resident length: ",e.what()}.trace(name);
+		}
+
+		const Header &header{file->get<Header>(0)};
+
+		// Header and source list (file name and timestamp, ended by an empty name).
+		{
+			size_t offset = sizeof(Header);
+			while(*file->get_ptr<char>(offset)) {
+				offset += strlen(file->get_ptr<char>(offset)) + 1 + sizeof(time_t);
+			}
+			stats.header = offset + 1;
+		}
+
+		if(header.symbols) {
+			const size_t *tables = file->get_ptr<size_t>(header.symbols);
+			stats.symbols = header.columns * sizeof(size_t);
+			for(size_t col = 0; col < header.columns; col++) {
+				if(tables[col]) {
+					stats.symbols += sizeof(SymbolTable);
+				}
+			}
+		}
+
+		if(header.dictionaries) {
+			const size_t *dictionaries = file->get_ptr<size_t>(header.dictionaries);
+			stats.dictionaries = header.columns * sizeof(size_t);
+			for(size_t col = 0; col < header.columns; col++) {
+				if(dictionaries[col]) {
+					stats.dictionaries += (1 + file->get<size_t>(dictionaries[col])) * sizeof(size_t);
+				}
+			}
+		}
+
+		// The strings are written between the source list and the primary index.
+		{
+			size_t used = stats.header + stats.symbols + stats.dictionaries;
+			stats.strings = header.primary_offset > used ? header.primary_offset - used : 0;
+		}
+
+		// The primary index ends on the first section written after it.
+		size_t first = stats.length;
+
+		if(header.indexes.count) {
+
+			first = std::min(first,header.indexes.offset);
+
+			const Index *index = file->get_ptr<Index>(header.indexes.offset);
+			for(size_t ix = 0; ix < header.indexes.count; ix++) {
+
+				first = std::min(first,index[ix].offset);
+
+				MemoryStatistics::Section section;
+				section.type = "indexes";
+				section.name = index[ix].column < cols.size() ? cols[index[ix].column]->name() : std::to_string(index[ix].column);
+				section.length = (1 + file->get<size_t>(index[ix].offset)) * sizeof(size_t);
+				stats.indexes.push_back(section);
+
+			}
+
+		}
+
+		if(header.sections.count) {
+
+			first = std::min(first,header.sections.offset);
+
+			const Section *item = file->get_ptr<Section>(header.sections.offset);
+			for(size_t ix = 0; ix < header.sections.count; ix++) {
+
+				first = std::min(first,item[ix].offset);
+
+				MemoryStatistics::Section section;
+
+				if(item[ix].type == Section::Bitmap) {
+
+					section.type = "bitmaps";
+					section.name = item[ix].id < cols.size() ? cols[item[ix].id]->name() : std::to_string(item[ix].id);
+					section.length = bitmap_length(*file,item[ix].offset,first);
+					stats.indexes.push_back(section);
+
+				} else if(item[ix].type == Section::Composite) {
+
+					const CompositeIndex &cindex{file->get<CompositeIndex>(item[ix].offset)};
+					const char *name = file->get_ptr<char>(cindex.name);
+					size_t qtdrec = file->get<size_t>(item[ix].offset + sizeof(CompositeIndex) + (cindex.columns * sizeof(uint16_t)));
+
+					first = std::min(first,cindex.name);
+
+					section.type = "composites";
+					section.name = name;
+					section.length = strlen(name) + 1 + sizeof(CompositeIndex) + (cindex.columns * sizeof(uint16_t)) + ((1 + qtdrec) * sizeof(size_t));
+					stats.indexes.push_back(section);
+
+				}
+
+			}
+
+		}
+
+		stats.primary = first > header.primary_offset ? first - header.primary_offset : 0;
+
+		// Everything else, api-call data, padding and the index and section lists.
+		{
+			size_t used = header.primary_offset + stats.primary;
+			for(const auto &section : stats.indexes) {
+				used += section.length;
+			}
+			stats.other = stats.length > used ? stats.length - used : 0;
+		}
+
+		return stats;
+
+	}
+
+ }
@@ -37,6 +37,8 @@
 
  #include <sys/mman.h>
  #include <cstdint>
+ #include <vector>
+ #include <algorithm>
 
  using namespace std;
 
@@ -53,7 +55,7 @@
 		}
 	}
 
-	DataStore::File::File(const char *filename) : fd{::open(filename,O_RDWR|O_CREAT,0640)} {
+	DataStore::File::File(const char *filename, bool writable) : fd{writable ? ::open(filename,O_RDWR|O_CREAT,0640) : ::open(filename,O_RDONLY)} {
 
 		if(Logger::enabled(Logger::Trace)) {
 			cout << "datastore\tStorage " << hex << this << dec << " constructed using " << filename << endl;
@@ -113,6 +115,87 @@
 
 	}
 
+	/// @brief madvise() on a block of the mapped file.
+	static void advise(const uint8_t *ptr, size_t offset, size_t length, int advice, const char *message) noexcept {
+
+		if(!(ptr && length)) {
+			return;
+		}
+
+		// madvise() requires a page aligned address.
+		static const size_t pagesize = (size_t) sysconf(_SC_PAGESIZE);
+		size_t from = offset - (offset % pagesize);
+
+		if(madvise((void *) (ptr+from),length + (offset-from),advice)) {
+			Logger::String{message,": ",strerror(errno)}.warning("datastore");
+		}
+
+	}
+
+	void DataStore::File::prefetch(size_t offset, size_t length) const noexcept {
+		Udjat::advise(ptr,offset,length,MADV_WILLNEED,"Unable to prefetch data file");
+	}
+
+	void DataStore::File::advise(size_t offset, size_t length, Access access) const noexcept {
+
+		static const int advices[] = {
+			MADV_NORMAL,
+			MADV_RANDOM,
+			MADV_SEQUENTIAL
+		};
+
+		Udjat::advise(ptr,offset,length,advices[access],"Unable to set data file access pattern");
+
+	}
+
+	void DataStore::File::huge_pages(size_t offset, size_t length) const noexcept {
+#ifdef MADV_HUGEPAGE
+		Udjat::advise(ptr,offset,length,MADV_HUGEPAGE,"Unable to use huge pages on data file");
+#else
+		Logger::String{"Huge pages are not available on this system"}.warning("datastore");
+#endif // MADV_HUGEPAGE
+	}
+
+	bool DataStore::File::lock() noexcept {
+
+		if(!ptr) {
+			return false;
+		}
+
+		if(mlock((void *) ptr,size())) {
+			Logger::String{"Unable to lock data file in memory: ",strerror(errno)}.warning("datastore");
+			return false;
+		}
+
+		return true;
+
+	}
+
+	size_t DataStore::File::resident() {
+
+		if(!ptr) {
+			return 0;
+		}
+
+		size_t length = size();
+		size_t pagesize = (size_t) sysconf(_SC_PAGESIZE);
+		std::vector<unsigned char> pages((length + pagesize - 1) / pagesize);
+
+		if(mincore((void *) ptr,length,pages.data())) {
+			throw std::system_error(errno,std::system_category(),"Unable to get resident pages of data file");
+		}
+
+		size_t rc = 0;
+		for(unsigned char page : pages) {
+			if(page & 1) {
+				rc += pagesize;
+			}
+		}
+
+		return std::min(rc,length);
+
+	}
+
 	void DataStore::File::unmap() {
 
 		std::lock_guard<std::mutex> lock(guard);
@@ -29,30 +29,28 @@
  namespace Udjat {
 
 	size_t DataStore::Column<in_addr>::save(Deduplicator &, const char *text) const {
+		return convert(text);
+	}
 
-		in_addr addr;
-		if(!inet_aton(text, &addr)) {
-			throw std::runtime_error(Logger::String{"Invalid IPV4 '",text,"'"});
-		}
-
-		return (size_t) htonl(addr.s_addr);
+	DataStore::Abstract::Column::Slot DataStore::Column<in_addr>::slot() const noexcept {
+		return Unsigned;
 	}
 
-	int DataStore::Column<in_addr>::comp(std::shared_ptr<File>, const size_t *row, const char *key) const {
+	size_t DataStore::Column<in_addr>::convert(const char *text) const {
 
 		in_addr addr;
-		if(!inet_aton(key, &addr)) {
-			throw std::runtime_error(Logger::String{"Invalid IPV4 '",key,"'"});
+		if(!inet_aton(text, &addr)) {
+			throw std::runtime_error(Logger::String{"Invalid IPV4 '",text,"'"});
 		}
 
-		return row[index] - htonl(addr.s_addr);
+		return (size_t) htonl(addr.s_addr);
 	}
 
-	bool DataStore::Column<in_addr>::less(std::shared_ptr<File>, const size_t *lrow, const size_t *rrow) const {
+	bool DataStore::Column<in_addr>::less(const std::shared_ptr<File> &, const Row &lrow, const Row &rrow) const {
 		return lrow[index] < rrow[index];
 	}
 
-	std::string DataStore::Column<in_addr>::to_string(std::shared_ptr<File>, const size_t *row) const {
+	std::string DataStore::Column<in_addr>::to_string(const std::shared_ptr<File> &, const Row &row) const {
 
 		in_addr addr;
 		memset(&addr,0,sizeof(addr));
@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Implements the hardware counters of the queries.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/statistics.h>
+ #include <udjat/tools/logger.h>
+ #include <linux/perf_event.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #include <cstring>
+ #include <atomic>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	bool DataStore::QueryStatistics::tlb_misses(uint64_t &value) noexcept {
+
+		/// @brief The data TLB load misses counter of this thread, closed when the thread exits.
+		static thread_local class Counter {
+		public:
+			int fd = -1;
+
+			Counter() {
+
+				struct perf_event_attr attr;
+				memset(&attr,0,sizeof(attr));
+				attr.size = sizeof(attr);
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+
+				fd = (int) syscall(__NR_perf_event_open,&attr,0,-1,-1,PERF_FLAG_FD_CLOEXEC);
+
+				if(fd < 0) {
+					// Usually perf_event_paranoid or a virtual machine without the PMU, warn only once.
+					static std::atomic_flag warned = ATOMIC_FLAG_INIT;
+					if(!warned.test_and_set()) {
+						try {
+							Logger::String{"Unable to open the dTLB load misses counter: ",strerror(errno)}.warning("datastore");
+						} catch(...) {
+						}
+					}
+				}
+
+			}
+
+			~Counter() {
+				if(fd >= 0) {
+					::close(fd);
+				}
+			}
+
+		} counter;
+
+		if(counter.fd < 0) {
+			return false;
+		}
+
+		return ::read(counter.fd,&value,sizeof(value)) == (ssize_t) sizeof(value);
+
+	}
+
+ }
@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Implements the store shared with other processes.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/datastore/container.h>
+ #include <udjat/tools/datastore/loader.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <private/structs.h>
+ #include <sys/types.h>
+ #include <sys/stat.h>
+ #include <sys/file.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <stdexcept>
+ #include <string>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Open & map the published store.
+	/// @return The published store, nullptr if there's none.
+	static std::shared_ptr<DataStore::File> published(const char *filename) {
+
+		if(access(filename,R_OK)) {
+			return std::shared_ptr<DataStore::File>();
+		}
+
+		auto file = make_shared<DataStore::File>(filename,false);
+		file->map();
+		return file;
+
+	}
+
+	std::shared_ptr<DataStore::File> DataStore::Container::shared() {
+
+		/// @brief The builder lock, released when closed.
+		class Lock {
+		public:
+			const int fd;
+
+			Lock(const std::string &filename) : fd{::open(filename.c_str(),O_RDWR|O_CREAT|O_CLOEXEC,0640)} {
+				if(fd < 0) {
+					throw std::system_error(errno,std::system_category(),filename);
+				}
+			}
+
+			~Lock() {
+				::close(fd);
+			}
+
+		} lock{string{shared_path} + ".lock"};
+
+		// Generation of the active store.
+		uint64_t generation = 0;
+		{
+			auto active = snapshot();
+			if(active) {
+				generation = active->get<Header>(0).generation;
+			}
+		}
+
+		Loader::CSV loader{*this,path,filespec};
+
+		/// @brief Check if the published store was built from the current sources.
+		auto updated = [this,&loader](const std::shared_ptr<File> &file) {
+			const Header &header{file->get<Header>(0)};
+			return header.columns == cols.size() && header.last_modified >= loader.last_modified();
+		};
+
+		// Wait for any other builder; the lock is released when closed.
+		if(flock(lock.fd,LOCK_EX)) {
+			throw std::system_error(errno,std::system_category(),"Unable to lock shared storage");
+		}
+
+		// We own the lock, use the published store unless it's outdated.
+		std::shared_ptr<File> file = published(shared_path);
+
+		if(file && !updated(file)) {
+			if(generation < file->get<Header>(0).generation) {
+				generation = file->get<Header>(0).generation;
+			}
+			file.reset();
+		}
+
+		if(!file) {
+
+			Logger::String{"Building shared storage '",shared_path,"'"}.trace(name);
+
+			/// @brief Remove the private file unless published.
+			class Temporary : public std::string {
+			public:
+				bool published = false;
+
+				Temporary(const char *path) : std::string{path} {
+					append(".");
+					append(std::to_string(getpid()));
+					unlink(c_str());
+				}
+
+				~Temporary() {
+					if(!published) {
+						unlink(c_str());
+					}
+				}
+
+			};
+
+			// Build on a private name, then replace the published one; the processes
+			// still using the previous store keep it until they unmap it.
+			Temporary filename{shared_path};
+
+			file = loader.load(filename.c_str());
+
+			// Publish a generation above the previous ones, unique for all processes sharing the store.
+			{
+				Header header;
+				file->read(0,&header,sizeof(header));
+				if(header.generation <= generation) {
+					header.generation = generation + 1;
+				}
+				file->write(0,header);
+			}
+
+			if(rename(filename.c_str(),shared_path)) {
+				throw std::system_error(errno,std::system_category(),"Unable to publish shared storage");
+			}
+			filename.published = true;
+
+			return file;
+
+		}
+
+		if(file->get<Header>(0).generation == generation) {
+			// Already active.
+			return std::shared_ptr<File>();
+		}
+
+		return file;
+
+	}
+
+ }
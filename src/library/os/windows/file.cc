@@ -48,7 +48,7 @@
 		}
 	}
 
-	DataStore::File::File(const char *filename) : fd{::open(filename,O_RDWR|O_CREAT,0640)} {
+	DataStore::File::File(const char *filename, bool writable) : fd{writable ? ::open(filename,O_RDWR|O_CREAT,0640) : ::open(filename,O_RDONLY)} {
 
 		if(Logger::enabled(Logger::Trace)) {
 			cout << "datastore\tStorage " << hex << this << dec << " constructed using " << filename << endl;
@@ -112,6 +112,48 @@
 
 	}
 
+	void DataStore::File::prefetch(size_t offset, size_t length) const noexcept {
+
+		if(!ptr) {
+			return;
+		}
+
+		// No madvise() on the mmap emulation, read one byte of each page.
+		volatile uint8_t value = 0;
+		for(size_t pos = offset; pos < (offset+length); pos += 4096) {
+			value ^= ptr[pos];
+		}
+		(void) value;
+
+	}
+
+	void DataStore::File::advise(size_t, size_t, Access) const noexcept {
+		// No madvise() on the mmap emulation.
+	}
+
+	void DataStore::File::huge_pages(size_t, size_t) const noexcept {
+		Logger::String{"Huge pages are not available on this system"}.warning("datastore");
+	}
+
+	bool DataStore::File::lock() noexcept {
+
+		if(!ptr) {
+			return false;
+		}
+
+		if(mlock((void *) ptr,size())) {
+			Logger::String{"Unable to lock data file in memory: ",strerror(errno)}.warning("datastore");
+			return false;
+		}
+
+		return true;
+
+	}
+
+	size_t DataStore::File::resident() {
+		throw system_error(ENOTSUP,system_category(),"Resident pages are not available on this platform");
+	}
+
 	void DataStore::File::unmap() {
 
 		std::lock_guard<std::mutex> lock(guard);
@@ -33,30 +33,28 @@
  namespace Udjat {
 
 	size_t DataStore::Column<in_addr>::save(Deduplicator &, const char *text) const {
+		return convert(text);
+	}
 
-		sockaddr_storage addr = IP::Factory(text);
-		if(addr.ss_family != AF_INET) {
-			throw runtime_error(Logger::String{"Cant convert address ",text," to an IPV4 value"});
-		}
-		return  (size_t) htonl(((sockaddr_in *) &addr)->sin_addr.s_addr);
-
+	DataStore::Abstract::Column::Slot DataStore::Column<in_addr>::slot() const noexcept {
+		return Unsigned;
 	}
 
-	int DataStore::Column<in_addr>::comp(std::shared_ptr<File>, const size_t *row, const char *key) const {
+	size_t DataStore::Column<in_addr>::convert(const char *text) const {
 
-		sockaddr_storage addr = IP::Factory(key);
+		sockaddr_storage addr = IP::Factory(text);
 		if(addr.ss_family != AF_INET) {
-				throw runtime_error(Logger::String{"Cant convert address ",text," to an IPV4 value"});
+			throw runtime_error(Logger::String{"Cant convert address ",text," to an IPV4 value"});
 		}
+		return  (size_t) htonl(((sockaddr_in *) &addr)->sin_addr.s_addr);
 
-		return row[index] - htonl(((sockaddr_in *) &addr)->sin_addr.s_addr);
 	}
 
-	bool DataStore::Column<in_addr>::less(std::shared_ptr<File>, const size_t *lrow, const size_t *rrow) const {
+	bool DataStore::Column<in_addr>::less(const std::shared_ptr<File> &, const Row &lrow, const Row &rrow) const {
 		return lrow[index] < rrow[index];
 	}
 
-	std::string DataStore::Column<in_addr>::to_string(std::shared_ptr<File>, const size_t *row) const {
+	std::string DataStore::Column<in_addr>::to_string(const std::shared_ptr<File> &, const Row &row) const {
 
 		in_addr addr;
 		memset(&addr,0,sizeof(addr));
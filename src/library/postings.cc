@@ -0,0 +1,120 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements posting lists.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/postings.h>
+ #include <private/bitmap.h>
+ #include <private/structs.h>
+ #include <algorithm>
+ #include <iterator>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	DataStore::Postings::Postings(const size_t *entries, size_t count) : records{entries,entries+count} {
+		std::sort(records.begin(),records.end());
+	}
+
+	DataStore::Postings::Postings(const File &file, const Bitmap &bitmap) {
+		records.reserve(bitmap.count());
+		bitmap.for_each([this,&file](size_t row){
+			records.push_back(record(file,row));
+		});
+	}
+
+	size_t DataStore::Postings::record(const File &file, size_t row) {
+
+		const Header &header{file.get<Header>(0)};
+
+		if(header.columnar) {
+			return row;
+		}
+
+		return header.primary_offset + (sizeof(size_t) * (1 + (row * header.columns)));
+
+	}
+
+	/// @brief Get the first element not before value, searching with exponential steps from 'from'.
+	static std::vector<size_t>::const_iterator gallop(std::vector<size_t>::const_iterator from, std::vector<size_t>::const_iterator end, size_t value) {
+
+		size_t step = 1;
+		auto to = from;
+		while(to != end && *to < value) {
+			from = to;
+			if((size_t) (end - to) <= step) {
+				to = end;
+				break;
+			}
+			to += step;
+			step *= 2;
+		}
+
+		return std::lower_bound(from,to,value);
+
+	}
+
+	DataStore::Postings & DataStore::Postings::operator&=(const Postings &postings) {
+
+		const std::vector<size_t> &small{records.size() <= postings.records.size() ? records : postings.records};
+		const std::vector<size_t> &large{records.size() <= postings.records.size() ? postings.records : records};
+
+		std::vector<size_t> selected;
+		selected.reserve(small.size());
+
+		auto ptr = large.begin();
+		for(size_t value : small) {
+			ptr = gallop(ptr,large.end(),value);
+			if(ptr == large.end()) {
+				break;
+			}
+			if(*ptr == value) {
+				selected.push_back(value);
+			}
+		}
+
+		records = std::move(selected);
+		return *this;
+
+	}
+
+	DataStore::Postings & DataStore::Postings::operator|=(const Postings &postings) {
+
+		std::vector<size_t> selected;
+		selected.reserve(records.size() + postings.records.size());
+
+		std::set_union(records.begin(),records.end(),postings.records.begin(),postings.records.end(),std::back_inserter(selected));
+
+		records = std::move(selected);
+		return *this;
+
+	}
+
+	void DataStore::Postings::for_each(const File &file, const std::function<void(const Row &row)> &method) const {
+		for(size_t record : records) {
+			method(Row::Factory(file,record));
+		}
+	}
+
+ }
@@ -29,7 +29,9 @@
  #include <udjat/tools/datastore/iterator.h>
  #include <udjat/net/ip/address.h>
  #include <private/iterator.h>
+ #include <private/structs.h>
  #include <stdexcept>
+ #include <algorithm>
 
  #ifdef _WIN32
 	#include <ws2tcpip.h>
@@ -53,7 +55,61 @@
 
 	}
 
-	std::shared_ptr<DataStore::Query> DataStore::Query::Factory(const XML::Node &node, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols) {
+	/// @brief Get IPV4 search key from request path.
+	/// @return The IPV4 address in host byte order.
+	static uint32_t get_ipv4_key(const Request &request) {
+
+		const char *path = request.path();
+		if(*path == '/') {
+			path++;
+		}
+
+		if(!(path && *path)) {
+			// Use request's ip address.
+			throw runtime_error("Incomplete - Cant search from request's origin address");
+		}
+
+		// Use IP from path
+		debug("Selecting network from '",path,"'");
+
+#ifdef _WIN32
+		sockaddr_storage addr = Udjat::IP::Factory(path);
+		if(addr.ss_family != AF_INET) {
+			throw runtime_error(Logger::String{"Cant convert address ",path," to an IPV4 value"});
+		}
+		return (uint32_t) htonl(((sockaddr_in *) &addr)->sin_addr.s_addr);
+#else
+		struct in_addr addr;
+
+		if(!inet_pton(AF_INET, path, &addr)) {
+			throw std::system_error(errno,std::system_category(),path);
+		}
+
+		return (uint32_t) htonl(addr.s_addr);
+#endif // _WIN32
+
+	}
+
+	size_t DataStore::Query::section(std::shared_ptr<File> file) const {
+
+		const Header &header{file->get<Header>(0)};
+		const Section *section{file->get_ptr<Section>(header.sections.offset)};
+
+		for(size_t ix = 0; ix < header.sections.count; ix++) {
+			if(section->type == Section::ApiCall && section->id == id) {
+				return section->offset;
+			}
+			section++;
+		}
+
+		return 0;
+	}
+
+	size_t DataStore::Query::build(const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &, std::shared_ptr<File>, const std::vector<size_t> &) const {
+		return 0;
+	}
+
+	std::shared_ptr<DataStore::Query> DataStore::Query::Factory(const XML::Node &node, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, uint16_t id) {
 
 		/// @brief IPV4 Network query.
 		class QueryNetV4 : public DataStore::Query {
@@ -66,7 +122,7 @@
 			} column;
 
 		public:
-			QueryNetV4(const XML::Node &node, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> cols) : DataStore::Query{node} {
+			QueryNetV4(const XML::Node &node, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> cols, uint16_t id) : DataStore::Query{node,id} {
 
 				const char *netsource = node.attribute("network-from").as_string("undefined");
 
@@ -93,41 +149,7 @@
 
 			DataStore::Iterator call(const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols,std::shared_ptr<File> file,const Request &request) const override {
 
-				size_t key = 0;
-				const char *path = request.path();
-				if(*path == '/') {
-					path++;
-				}
-
-				if(path && *path) {
-
-					// Use IP from path
-					debug("Selecting network from '",path,"'");
-
-#ifdef _WIN32
-					sockaddr_storage addr = Udjat::IP::Factory(path);
-					if(addr.ss_family != AF_INET) {
-						throw runtime_error(Logger::String{"Cant convert address ",path," to an IPV4 value"});
-					}
-					key = (size_t) &((sockaddr_in *) &addr)->sin_addr.s_addr;
-#else
-					struct in_addr addr;
-
-					if(!inet_pton(AF_INET, path, &addr)) {
-						throw std::system_error(errno,std::system_category(),path);
-					}
-
-					key = (size_t) htonl(addr.s_addr);
-#endif // _WIN32
-
-
-				} else {
-
-					// Use request's ip address.
-
-					throw runtime_error("Incomplete - Cant search from request's origin address");
-
-				}
+				uint32_t key = get_ipv4_key(request);
 
 				class NetworkHandler : public ColumnKeyHandler {
 				private:
@@ -141,7 +163,7 @@
 
 					int filter(const Iterator &it) const override {
 
-						const size_t *rptr = rowptr(it);
+						const Row rptr{rowptr(it)};
 
 						uint32_t mask = rptr[maskcol];
 						uint32_t brd = 0xffffffff&~mask;	// Set all non network part bits to 1 (broadcast address).
@@ -176,6 +198,10 @@
 
 					}
 
+					QueryStatistics::Kind kind() const noexcept override {
+						return QueryStatistics::NetV4;
+					}
+
 
 				};
 
@@ -189,9 +215,150 @@
 
 		};
 
+		/// @brief IPV4 Range query.
+		class QueryRangeV4 : public DataStore::Query {
+		private:
+
+			struct Column {
+				uint16_t from;		///< @brief ID of the first IP column.
+				uint16_t to;		///< @brief ID of the last IP column.
+			} column;
+
+			/// @brief Interval, used while building the section.
+			struct Interval {
+				uint32_t from;
+				uint32_t to;
+				size_t record;
+			};
+
+		public:
+			QueryRangeV4(const XML::Node &node, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> cols, uint16_t id) : DataStore::Query{node,id} {
+
+				column.from = get_column_by_name(cols,node.attribute("start-from").as_string("first"));
+				if(!dynamic_cast<DataStore::Column<in_addr> *>(cols[column.from].get())) {
+					throw runtime_error("Invalid column type");
+				}
+
+				column.to = get_column_by_name(cols,node.attribute("end-from").as_string("last"));
+				if(!dynamic_cast<DataStore::Column<in_addr> *>(cols[column.to].get())) {
+					throw runtime_error("Invalid column type");
+				}
+
+			}
+
+			/// @brief Write sorted, non overlapping interval array.
+			///
+			/// Section layout is the interval count followed by the record offsets, the
+			/// first addresses and the last addresses, the addresses as packed uint32_t.
+			size_t build(const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &, std::shared_ptr<File> file, const std::vector<size_t> &records) const override {
+
+				std::vector<Interval> intervals;
+				intervals.reserve(records.size());
+
+				file->map();
+				for(size_t record : records) {
+
+					const Row row{Row::Factory(*file,record)};
+					size_t from = row[column.from];
+					size_t to = row[column.to];
+
+					if(!(from || to)) {
+						continue;	// Empty range.
+					}
+
+					if(from > to) {
+						Logger::String{"Ignoring reversed range on api-call '",path(),"'"}.warning("datastore");
+						continue;
+					}
+
+					intervals.push_back(Interval{(uint32_t) from, (uint32_t) to, record});
+				}
+				file->unmap();
+
+				std::sort(intervals.begin(),intervals.end(),[](const Interval &l, const Interval &r){
+					return l.from < r.from;
+				});
+
+				// Remove overlaps, the first range to start owns the shared addresses.
+				{
+					size_t last = 0;
+					for(size_t ix = 1; ix < intervals.size(); ix++) {
+
+						Interval &interval = intervals[ix];
+						if(interval.from <= intervals[last].to) {
+							if(interval.to <= intervals[last].to) {
+								continue;	// Fully covered, ignore it.
+							}
+							interval.from = intervals[last].to + 1;
+						}
+
+						intervals[++last] = interval;
+
+					}
+					if(!intervals.empty()) {
+						intervals.resize(last+1);
+					}
+				}
+
+				debug("Writing ",intervals.size()," ipv4 range(s)");
+
+				size_t qtdrec = intervals.size();
+				size_t offset = file->write(qtdrec);
+
+				for(const Interval &interval : intervals) {
+					file->write(interval.record);
+				}
+				for(const Interval &interval : intervals) {
+					file->write(interval.from);
+				}
+				for(const Interval &interval : intervals) {
+					file->write(interval.to);
+				}
+
+				return offset;
+			}
+
+			DataStore::Iterator call(const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols,std::shared_ptr<File> file,const Request &request) const override {
+
+				uint32_t key = get_ipv4_key(request);
+
+				auto records = make_shared<CustomKeyHandler>(QueryStatistics::IPv4Range);
+
+				size_t offset = section(file);
+				if(offset) {
+
+					size_t qtdrec = file->get<size_t>(offset);
+					const size_t *record = file->get_ptr<size_t>(offset+sizeof(size_t));
+					const uint32_t *from = (const uint32_t *) (record+qtdrec);
+					const uint32_t *to = from+qtdrec;
+
+					// Get the last range starting before or on key.
+					const uint32_t *ptr = std::upper_bound(from,from+qtdrec,key);
+					if(ptr != from) {
+						size_t ix = (ptr - from) - 1;
+						if(key <= to[ix]) {
+							records->push_back(Row::Factory(*file,record[ix]));
+						}
+					}
+
+				}
+
+				Iterator it{file,cols,records};
+				it = 0;
+
+				return it;
+
+			}
+
+		};
+
 		const char *type = node.attribute("search-engine").as_string("undefined");
 		if(!strcasecmp(type,"netv4")) {
-			return make_shared<QueryNetV4>(node,cols);
+			return make_shared<QueryNetV4>(node,cols,id);
+		}
+
+		if(!strcasecmp(type,"ipv4-range")) {
+			return make_shared<QueryRangeV4>(node,cols,id);
 		}
 
 		throw runtime_error(Logger::String{"Unknown or invalid search-engine '",type,"'"});
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements row accessor.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/row.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <private/structs.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	DataStore::Row::Row(const File &file, size_t n)
+		: base{file.get_ptr<uint8_t>(0)}, arrays{file.get_ptr<Array>(file.get<Header>(0).columnar)}, number{n} {
+	}
+
+	DataStore::Row DataStore::Row::Factory(const File &file, size_t record) {
+
+		if(file.get<Header>(0).columnar) {
+			return Row{file,record};
+		}
+
+		return Row{file.get_ptr<size_t>(record)};
+
+	}
+
+ }
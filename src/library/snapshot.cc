@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements store generation publisher.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/snapshot.h>
+ #include <thread>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<DataStore::File> DataStore::Snapshot::get() const noexcept {
+
+		for(;;) {
+
+			uint8_t ix = active.load();
+			Slot &slot{slots[ix]};
+
+			slot.readers++;
+			if(active.load() == ix) {
+				// Still active, the writer will not touch the slot until we leave.
+				std::shared_ptr<File> file{slot.file};
+				slot.readers--;
+				return file;
+			}
+			slot.readers--;
+
+		}
+
+	}
+
+	void DataStore::Snapshot::wait(const Slot &slot) noexcept {
+		while(slot.readers.load()) {
+			std::this_thread::yield();
+		}
+	}
+
+	void DataStore::Snapshot::set(std::shared_ptr<File> file) {
+
+		std::lock_guard<std::mutex> lock{guard};
+
+		uint8_t next = active.load() ^ 1;
+
+		// Readers registered on the inactive slot will fail and retry on the active one.
+		wait(slots[next]);
+		slots[next].file = file;
+		active.store(next);
+
+		// Release the previous generation, the readers already holding it will keep it mapped.
+		Slot &previous{slots[next ^ 1]};
+		wait(previous);
+		previous.file.reset();
+
+	}
+
+ }
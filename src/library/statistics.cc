@@ -0,0 +1,450 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Implements store build and query statistics.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/datastore/statistics.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <udjat/tools/timestamp.h>
+ #include <udjat/tools/logger.h>
+ #include <cstring>
+ #include <cmath>
+
+#ifdef _WIN32
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif // _WIN32
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Get the CPU time of the calling thread, in seconds.
+	/// @details The process CPU time would add the queries served while loading.
+	static double thread_cpu_time() noexcept {
+
+#ifdef _WIN32
+		FILETIME creation, exit, kernel, user;
+		if(!GetThreadTimes(GetCurrentThread(),&creation,&exit,&kernel,&user)) {
+			return 0;
+		}
+
+		// Times in 100 ns units.
+		ULARGE_INTEGER k, u;
+		k.LowPart = kernel.dwLowDateTime;
+		k.HighPart = kernel.dwHighDateTime;
+		u.LowPart = user.dwLowDateTime;
+		u.HighPart = user.dwHighDateTime;
+		return ((double) (k.QuadPart + u.QuadPart)) / 1e7;
+#else
+		struct timespec ts;
+		if(clock_gettime(CLOCK_THREAD_CPUTIME_ID,&ts)) {
+			return 0;
+		}
+		return ((double) ts.tv_sec) + (((double) ts.tv_nsec) / 1e9);
+#endif // _WIN32
+
+	}
+
+	DataStore::LoadStatistics::Timer::Timer(LoadStatistics &s, File &f, const char *n)
+		: stats{s}, file{f}, name{n}, wall{std::chrono::steady_clock::now()}, cpu{thread_cpu_time()}, length{f.size()} {
+	}
+
+	DataStore::LoadStatistics::Timer::~Timer() {
+
+		Phase phase;
+		phase.name = name;
+		phase.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+		phase.cpu = thread_cpu_time() - cpu;
+
+		try {
+			phase.bytes = file.size() - length;
+		} catch(const std::exception &e) {
+			Logger::String{"Unable to get store length: ",e.what()}.warning("datastore");
+		}
+
+		// Phases running more than once (one for each column) are added together.
+		for(auto &item : stats.phases) {
+			if(!strcasecmp(item.name,name)) {
+				item.wall += phase.wall;
+				item.cpu += phase.cpu;
+				item.bytes += phase.bytes;
+				return;
+			}
+		}
+
+		stats.phases.push_back(phase);
+
+	}
+
+	const DataStore::LoadStatistics::Phase * DataStore::LoadStatistics::phase(const char *name) const noexcept {
+		for(const auto &phase : phases) {
+			if(!strcasecmp(phase.name,name)) {
+				return &phase;
+			}
+		}
+		return nullptr;
+	}
+
+	Udjat::Value & DataStore::LoadStatistics::get(Udjat::Value &value) const {
+
+		double wall = 0, cpu = 0;
+		for(const auto &phase : phases) {
+			wall += phase.wall;
+			cpu += phase.cpu;
+		}
+
+		value["started"] = TimeStamp{started};
+		value["time"] = wall;
+		value["cpu"] = cpu;
+		value["files"] = sources.files;
+		value["bytes"] = sources.bytes;
+		value["rows"] = sources.rows;
+		value["records"] = records;
+		value["length"] = length;
+		value["process-peak-rss"] = process_peak_rss;
+
+		{
+			const Phase *phase = this->phase("sources");
+			if(phase && phase->wall > 0) {
+				value["rows-per-second"] = ((double) sources.rows) / phase->wall;
+				value["bytes-per-second"] = ((double) sources.bytes) / phase->wall;
+			}
+		}
+
+		value["dedup-lookups"] = dedup.lookups;
+		value["dedup-hit-ratio"] = dedup.lookups ? (((double) dedup.hits) / dedup.lookups) : 0.0;
+		value["distinct-blocks"] = dedup.blocks;
+		value["dedup-saved"] = dedup.saved;
+
+		Udjat::Value &items{value["phases"]};
+		for(const auto &phase : phases) {
+
+			Udjat::Value &item{items[phase.name]};
+			item["time"] = phase.wall;
+			item["cpu"] = phase.cpu;
+			item["bytes"] = phase.bytes;
+
+			if(!strcasecmp(phase.name,"sources")) {
+				// Reading the sources is split between parsing, converting and indexing the rows.
+				item["parse"] = phase.wall - (sources.convert + sources.insert);
+				item["convert"] = sources.convert;
+				item["insert"] = sources.insert;
+			}
+
+		}
+
+		return value;
+	}
+
+	Udjat::Value & DataStore::MemoryStatistics::get(Udjat::Value &value) const {
+
+		value["length"] = length;
+		value["resident"] = resident;
+		value["header"] = header;
+		value["symbols"] = symbols;
+		value["strings"] = strings;
+		value["dictionaries"] = dictionaries;
+		value["primary"] = primary;
+		for(const auto &section : indexes) {
+			value[section.type][section.name.c_str()] = section.length;
+		}
+		value["other"] = other;
+		value["deduplicated"] = deduplicated;
+		value["generations"] = generations;
+		value["pinned"] = pinned;
+
+		return value;
+	}
+
+	static const char * kind_names[] = {
+		"primary",
+		"index",
+		"range",
+		"composite",
+		"contains",
+		"bitmap",
+		"scan",
+		"filter",
+		"row",
+		"netv4",
+		"ipv4-range",
+		"batch",
+		"aggregate",
+		"other"
+	};
+
+	const char * DataStore::QueryStatistics::to_string(const Kind kind) noexcept {
+		if(kind < Kinds) {
+			return kind_names[kind];
+		}
+		return "other";
+	}
+
+	/// @brief The timer running on this thread.
+	static thread_local DataStore::QueryStatistics::Timer *current_timer = nullptr;
+
+	/// @brief Get the histogram bucket for a latency.
+	static size_t bucket(uint64_t nanoseconds, size_t buckets) noexcept {
+
+		if(nanoseconds < 8) {
+			return (size_t) nanoseconds;
+		}
+
+		size_t exponent = 0;
+		for(uint64_t value = nanoseconds; value > 1; value >>= 1) {
+			exponent++;
+		}
+
+		size_t rc = ((exponent - 2) * 8) + ((nanoseconds >> (exponent - 3)) & 7);
+		return rc < buckets ? rc : buckets - 1;
+
+	}
+
+	/// @brief Get the latency at the middle of a histogram bucket.
+	static double latency(size_t bucket) noexcept {
+
+		if(bucket < 8) {
+			return (double) bucket;
+		}
+
+		size_t exponent = (bucket / 8) + 2;
+		double width = std::ldexp(1.0,(int) (exponent - 3));
+		return ((8 + (bucket % 8)) * width) + (width / 2);
+
+	}
+
+	DataStore::QueryStatistics::Timer::Timer(QueryStatistics &s) : stats{s}, started{std::chrono::steady_clock::now()}, previous{current_timer} {
+		current_timer = this;
+		counting = (stats.tlb && tlb_misses(misses));
+	}
+
+	DataStore::QueryStatistics::Timer::~Timer() {
+
+		uint64_t nanoseconds = (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+
+		uint64_t tlb = 0;
+		if(counting && tlb_misses(tlb) && tlb >= misses) {
+			tlb -= misses;
+		} else {
+			tlb = 0;
+		}
+
+		current_timer = previous;
+		stats.record(type,nanoseconds,rows,bytes,tlb);
+
+	}
+
+	DataStore::QueryStatistics::QueryStatistics() {
+		for(auto &shard : shards) {
+			shard.store(nullptr);
+		}
+	}
+
+	DataStore::QueryStatistics::~QueryStatistics() {
+		for(auto &shard : shards) {
+			delete shard.load();
+		}
+	}
+
+	DataStore::QueryStatistics::Shard & DataStore::QueryStatistics::shard() {
+
+		static std::atomic<size_t> threads{0};
+		static thread_local size_t slot = (threads++ % Shards);
+
+		Shard *shard = shards[slot].load(std::memory_order_acquire);
+		if(shard) {
+			return *shard;
+		}
+
+		// First query on this shard, allocate it; another thread can win the race.
+		Shard *allocated = new Shard();
+		if(shards[slot].compare_exchange_strong(shard,allocated,std::memory_order_acq_rel)) {
+			return *allocated;
+		}
+
+		delete allocated;
+		return *shard;
+
+	}
+
+	void DataStore::QueryStatistics::record(const Kind kind, uint64_t nanoseconds, size_t rows, size_t bytes, uint64_t tlb_misses) {
+
+		Counters &counters{shard().kinds[kind < Kinds ? kind : Other]};
+
+		counters.count.fetch_add(1,std::memory_order_relaxed);
+		counters.rows.fetch_add(rows,std::memory_order_relaxed);
+		counters.bytes.fetch_add(bytes,std::memory_order_relaxed);
+		counters.total.fetch_add(nanoseconds,std::memory_order_relaxed);
+		counters.tlb.fetch_add(tlb_misses,std::memory_order_relaxed);
+		counters.buckets[bucket(nanoseconds,Buckets)].fetch_add(1,std::memory_order_relaxed);
+
+		uint64_t max = counters.max.load(std::memory_order_relaxed);
+		while(nanoseconds > max && !counters.max.compare_exchange_weak(max,nanoseconds,std::memory_order_relaxed));
+
+	}
+
+	void DataStore::QueryStatistics::served(size_t rows, size_t bytes) noexcept {
+		if(current_timer) {
+			current_timer->rows += rows;
+			current_timer->bytes += bytes;
+		}
+	}
+
+	std::vector<DataStore::QueryStatistics::Summary> DataStore::QueryStatistics::summary() const {
+
+		std::vector<Summary> summaries;
+
+		for(size_t kind = 0; kind < Kinds; kind++) {
+
+			Summary summary;
+			summary.kind = (Kind) kind;
+
+			uint64_t total = 0, max = 0;
+			std::vector<uint64_t> buckets(Buckets,0);
+
+			for(const auto &item : shards) {
+
+				const Shard *shard = item.load(std::memory_order_acquire);
+				if(!shard) {
+					continue;
+				}
+
+				const Counters &counters{shard->kinds[kind]};
+				summary.count += counters.count.load(std::memory_order_relaxed);
+				summary.rows += counters.rows.load(std::memory_order_relaxed);
+				summary.bytes += counters.bytes.load(std::memory_order_relaxed);
+				summary.tlb_misses += counters.tlb.load(std::memory_order_relaxed);
+				total += counters.total.load(std::memory_order_relaxed);
+				max = std::max(max,(uint64_t) counters.max.load(std::memory_order_relaxed));
+
+				for(size_t ix = 0; ix < Buckets; ix++) {
+					buckets[ix] += counters.buckets[ix].load(std::memory_order_relaxed);
+				}
+
+			}
+
+			// The counters are not read atomically, use the bucket total for the percentiles.
+			uint64_t count = 0;
+			for(uint64_t value : buckets) {
+				count += value;
+			}
+
+			if(!count) {
+				continue;
+			}
+
+			summary.mean = ((double) total) / summary.count / 1000;
+			summary.max = ((double) max) / 1000;
+
+			struct {
+				double quantile;
+				double &value;
+			} percentiles[] = {
+				{ 0.5, summary.p50 },
+				{ 0.9, summary.p90 },
+				{ 0.99, summary.p99 },
+				{ 0.999, summary.p999 },
+			};
+
+			for(auto &percentile : percentiles) {
+
+				uint64_t rank = (uint64_t) std::ceil(percentile.quantile * count);
+				uint64_t seen = 0;
+
+				for(size_t ix = 0; ix < Buckets; ix++) {
+					seen += buckets[ix];
+					if(seen >= rank) {
+						percentile.value = std::min(latency(ix),(double) max) / 1000;
+						break;
+					}
+				}
+
+			}
+
+			summaries.push_back(summary);
+
+		}
+
+		return summaries;
+
+	}
+
+	Udjat::Value & DataStore::QueryStatistics::get(Udjat::Value &value) const {
+
+		for(const auto &summary : summary()) {
+
+			Udjat::Value &item{value[to_string(summary.kind)]};
+			item["count"] = summary.count;
+			item["rows"] = summary.rows;
+			item["bytes"] = summary.bytes;
+			item["mean"] = summary.mean;
+			item["p50"] = summary.p50;
+			item["p90"] = summary.p90;
+			item["p99"] = summary.p99;
+			item["p999"] = summary.p999;
+			item["max"] = summary.max;
+
+			if(tlb) {
+				item["dtlb-load-misses"] = summary.tlb_misses;
+				item["dtlb-misses-per-query"] = ((double) summary.tlb_misses) / summary.count;
+			}
+
+		}
+
+		return value;
+	}
+
+	void DataStore::QueryStatistics::get(Udjat::Response::Table &value) const {
+
+		auto summaries{summary()};
+
+		std::vector<std::string> names{"kind","count","rows","bytes","mean","p50","p90","p99","p999","max"};
+		if(tlb) {
+			names.push_back("dtlb-load-misses");
+		}
+		value.start(names);
+
+		for(const auto &summary : summaries) {
+			value.push_back(to_string(summary.kind));
+			value.push_back(summary.count);
+			value.push_back(summary.rows);
+			value.push_back(summary.bytes);
+			value.push_back(summary.mean);
+			value.push_back(summary.p50);
+			value.push_back(summary.p90);
+			value.push_back(summary.p99);
+			value.push_back(summary.p999);
+			value.push_back(summary.max);
+			if(tlb) {
+				value.push_back(summary.tlb_misses);
+			}
+		}
+
+		value.count(summaries.size());
+
+	}
+
+ }
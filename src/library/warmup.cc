@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2023 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Implements the warm-up of a new store generation.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/datastore/container.h>
+ #include <udjat/tools/datastore/file.h>
+ #include <private/structs.h>
+ #include <private/iterator.h>
+ #include <chrono>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Number of index entries to touch, the first levels of the binary search.
+	static const size_t probes = 1024;
+
+	/// @brief Touch the rows visited by the first steps of a binary search on the handler.
+	static void touch(const std::shared_ptr<DataStore::File> file, const std::vector<std::shared_ptr<DataStore::Abstract::Column>> &cols, std::shared_ptr<DataStore::Iterator::Handler> handler) {
+
+		size_t length = handler->size();
+		if(!length) {
+			return;
+		}
+
+		DataStore::Iterator it{file,cols,handler};
+		size_t steps = std::min(length,probes);
+
+		for(size_t step = 0; step < steps; step++) {
+			it = (step * length) / steps;
+			for(size_t col = 0; col < cols.size(); col++) {
+				it[col];
+			}
+		}
+
+	}
+
+	void DataStore::Container::prefetch(std::shared_ptr<File> file) {
+
+		auto start = std::chrono::steady_clock::now();
+
+		// Ask for the indexes and records, they are after the string heap.
+		{
+			const Header &header{file->get<Header>(0)};
+			size_t length = file->size();
+			if(header.primary_offset < length) {
+				file->prefetch(header.primary_offset,length - header.primary_offset);
+			}
+		}
+
+		// Touch the top levels of every sorted index.
+		touch(file,cols,make_shared<PrimaryKeyHandler>(file));
+
+		for(size_t col = 0; col < cols.size(); col++) {
+			if(cols[col]->indexed()) {
+				touch(file,cols,make_shared<ColumnKeyHandler>(file,(uint16_t) col));
+			}
+		}
+
+		for(const auto &composite : composites) {
+			size_t offset = CompositeKeyHandler::find(file,composite.name);
+			if(offset) {
+				touch(file,cols,make_shared<CompositeKeyHandler>(Iterator{file,cols},offset,""));
+			}
+		}
+
+		// Replay the recent searches.
+		std::deque<std::string> recent;
+		{
+			std::lock_guard<std::mutex> lock{warmup.guard};
+			recent = warmup.recent;
+		}
+
+		for(const auto &path : recent) {
+			try {
+				Iterator it{Iterator::Factory(file,cols,path.c_str())};
+				for(size_t row = 0; it && row < probes; row++) {
+					it.primary_key();
+					++it;
+				}
+			} catch(const std::exception &e) {
+				Logger::String{"Ignoring warm-up search '",path.c_str(),"': ",e.what()}.trace(name);
+			}
+		}
+
+		Logger::String{
+			"Warm-up of new storage took ",
+			(unsigned long) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+			"ms (",recent.size()," search(es) replayed)"
+		}.trace(name);
+
+	}
+
+ }
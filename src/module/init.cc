@@ -90,6 +90,22 @@
 
 			debug("Found container for '",request.path(),"'");
 
+			request.pop();	// Remove db name.
+
+			{
+				// Query latency histograms, live data: never cached.
+				const char *path = request.path();
+				while(*path && *path == '/') {
+					path++;
+				}
+
+				if( ((HTTP::Method) request) == HTTP::Get && !strcasecmp(path,"_stats")) {
+					debug("HTTP GET (statistics)");
+					db->query_statistics().get(response);
+					return true;
+				}
+			}
+
 			{
 				time_t timestamp = db->last_modified();
 				response.last_modified(timestamp);
@@ -99,9 +115,22 @@
 				}
 			}
 
-			request.pop();	// Remove db name.
+			DataStore::QueryStatistics::Timer timer{db->query_statistics()};
+
+			if( ((HTTP::Method) request) == HTTP::Post) {
+				debug("HTTP POST");
+				timer.kind(DataStore::QueryStatistics::Batch);
+				return db->batch(request,response);
+			}
+
+			if( ((HTTP::Method) request) == HTTP::Get && db->aggregate(request,response)) {
+				debug("HTTP GET (aggregation)");
+				timer.kind(DataStore::QueryStatistics::Aggregate);
+				return true;
+			}
 
 			DataStore::Iterator it = db->find(request);
+			timer.kind(it.kind());
 			if(!it) {
 				return false;
 			}
@@ -109,7 +138,7 @@
 			if( ((HTTP::Method) request) == HTTP::Get) {
 
 				debug("HTTP GET");
-				it.get(response);
+				it.get(request,response);
 
 			} else if( ((HTTP::Method) request) == HTTP::Head) {
 